@@ -0,0 +1,19 @@
+/*
+  ==============================================================================
+
+    JuceHeader.h
+    Created: 20 Oct 2026 10:14:52am
+    Author:  Ryan Baker
+
+    Stands in for the header juce_generate_juce_header makes for the plugin.
+    That function only works on targets made by juce_add_plugin and friends,
+    not on a pybind11 module, and the engines only need juce_dsp anyway. It
+    is found before any generated one because the module adds this
+    directory to its include path.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
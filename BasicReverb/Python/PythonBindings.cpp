@@ -0,0 +1,302 @@
+/*
+  ==============================================================================
+
+    PythonBindings.cpp
+    Created: 19 Oct 2026 4:52:09pm
+    Author:  Ryan Baker
+
+    pybind11 bindings for ReverbEngine, for rendering training data straight
+    into NumPy arrays instead of going through WAV files.
+
+    Arrays are never copied on the way in or out. Inputs must already be
+    C-contiguous float32 of shape (channels, samples), otherwise the call
+    raises TypeError rather than silently processing a temporary copy.
+    Processing releases the GIL, and render_impulse_responses spreads a
+    batch over worker threads that write directly into the returned array.
+    Calls on one Reverb from several Python threads take turns.
+
+  ==============================================================================
+*/
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include <JuceHeader.h>
+#include "ReverbEngine.h"
+
+namespace py = pybind11;
+
+namespace {
+
+using FloatArray = py::array_t<float, py::array::c_style>;
+
+// Columns of the parameter table passed to render_impulse_responses.
+enum ParameterColumn { roomSize, damping, wetLevel, dryLevel, width, freeze, numParameterColumns };
+
+juce::dsp::Reverb::Parameters makeParameters(float newRoomSize, float newDamping, float newWetLevel,
+                                             float newDryLevel, float newWidth, bool newFreeze)
+{
+    juce::dsp::Reverb::Parameters params;
+    params.roomSize   = newRoomSize;
+    params.damping    = newDamping;
+    params.wetLevel   = newWetLevel;
+    params.dryLevel   = newDryLevel;
+    params.width      = newWidth;
+    params.freezeMode = newFreeze ? 1.f : 0.f;
+    return params;
+}
+
+// Runs an engine over channel pointers, one prepared block at a time.
+void processChannels(ReverbEngine& engine, const float* const* input, float* const* output,
+                     int numChannels, int numSamples, int maxBlockSize)
+{
+    std::array<const float*, 2> in {};
+    std::array<float*, 2> out {};
+
+    for (int start = 0; start < numSamples; start += maxBlockSize)
+    {
+        const int num = juce::jmin(maxBlockSize, numSamples - start);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            in[(size_t) channel] = input[channel] + start;
+            out[(size_t) channel] = output[channel] + start;
+        }
+
+        juce::dsp::AudioBlock<float> outputBlock(out.data(), (size_t) numChannels, (size_t) num);
+
+        if (input == output)
+        {
+            juce::dsp::ProcessContextReplacing<float> context(outputBlock);
+            engine.process(context);
+        }
+        else
+        {
+            juce::dsp::AudioBlock<const float> inputBlock(in.data(), (size_t) numChannels, (size_t) num);
+            juce::dsp::ProcessContextNonReplacing<float> context(inputBlock, outputBlock);
+            engine.process(context);
+        }
+    }
+}
+
+//==============================================================================
+class PythonReverb
+{
+public:
+    PythonReverb(double newSampleRate, int newMaxBlockSize, int newNumChannels,
+                 ReverbEngine::Type type, FDNReverb::Quality quality)
+        : sampleRate(newSampleRate), maxBlockSize(newMaxBlockSize), numChannels(newNumChannels)
+    {
+        if (numChannels != 1 && numChannels != 2)
+            throw py::value_error("channels must be 1 or 2");
+
+        if (maxBlockSize < 1 || sampleRate <= 0.0)
+            throw py::value_error("sample_rate and max_block_size must be positive");
+
+        engine.setType(type);
+        engine.setQuality(quality);
+        engine.prepare({ sampleRate, (juce::uint32) maxBlockSize, (juce::uint32) numChannels });
+    }
+
+    void setParameters(float newRoomSize, float newDamping, float newWetLevel,
+                       float newDryLevel, float newWidth, bool newFreeze)
+    {
+        const std::lock_guard<std::mutex> lock(engineLock);
+        engine.setParameters(makeParameters(newRoomSize, newDamping, newWetLevel, newDryLevel, newWidth, newFreeze));
+    }
+
+    void reset()
+    {
+        const std::lock_guard<std::mutex> lock(engineLock);
+        engine.reset();
+    }
+
+    // Processes input into output, or in place when output is None.
+    void process(FloatArray input, std::optional<FloatArray> output)
+    {
+        checkShape(input, "input");
+
+        std::array<const float*, 2> inputPointers {};
+        std::array<float*, 2> outputPointers {};
+        const auto numSamples = (int) input.shape(1);
+        const bool inPlace = ! output.has_value() || output->data() == input.data();
+
+        if (! inPlace)
+        {
+            checkShape(*output, "output");
+
+            if (output->shape(1) != input.shape(1))
+                throw py::value_error("input and output must have the same number of samples");
+        }
+
+        if (numSamples == 0)
+            return;
+
+        if (! inPlace)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                inputPointers[(size_t) channel] = input.data(channel, 0);
+                outputPointers[(size_t) channel] = output->mutable_data(channel, 0);
+            }
+        }
+        else
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+                outputPointers[(size_t) channel] = input.mutable_data(channel, 0);
+        }
+
+        const float* const* in = outputPointers.data();
+        if (! inPlace)
+            in = inputPointers.data();
+
+        // The GIL goes first, so a thread waiting for the engine never holds it.
+        py::gil_scoped_release release;
+        const std::lock_guard<std::mutex> lock(engineLock);
+        processChannels(engine, in, outputPointers.data(), numChannels, numSamples, maxBlockSize);
+    }
+
+    double getSampleRate() const noexcept { return sampleRate; }
+    int getMaxBlockSize() const noexcept  { return maxBlockSize; }
+    int getNumChannels() const noexcept   { return numChannels; }
+
+private:
+    void checkShape(const FloatArray& array, const char* name) const
+    {
+        if (array.ndim() != 2 || array.shape(0) != numChannels)
+            throw py::value_error(std::string(name) + " must have shape (" + std::to_string(numChannels) + ", samples)");
+    }
+
+    double sampleRate;
+    int maxBlockSize, numChannels;
+    ReverbEngine engine;
+    std::mutex engineLock;
+};
+
+//==============================================================================
+// Renders one impulse response per row of the parameter table, into an array of shape
+// (rows, channels, length) that is filled in place by the worker threads.
+FloatArray renderImpulseResponses(FloatArray parameters, ReverbEngine::Type type, FDNReverb::Quality quality,
+                                  double sampleRate, int length, int numChannels, int maxBlockSize, int numThreads)
+{
+    if (parameters.ndim() != 2 || parameters.shape(1) != numParameterColumns)
+        throw py::value_error("parameters must have shape (n, 6): room_size, damping, wet_level, dry_level, width, freeze");
+
+    if (numChannels != 1 && numChannels != 2)
+        throw py::value_error("channels must be 1 or 2");
+
+    if (length < 1 || maxBlockSize < 1 || sampleRate <= 0.0)
+        throw py::value_error("sample_rate, length and max_block_size must be positive");
+
+    const auto numResponses = (size_t) parameters.shape(0);
+    FloatArray result({ (py::ssize_t) numResponses, (py::ssize_t) numChannels, (py::ssize_t) length });
+
+    const float* table = parameters.data();
+    float* destination = result.mutable_data();
+
+    if (numThreads <= 0)
+        numThreads = juce::jmax(1, juce::SystemStats::getNumCpus());
+
+    {
+        py::gil_scoped_release release;
+
+        std::atomic<size_t> next { 0 };
+
+        auto worker = [&]
+        {
+            ReverbEngine engine;
+            engine.setType(type);
+            engine.setQuality(quality);
+            engine.prepare({ sampleRate, (juce::uint32) maxBlockSize, (juce::uint32) numChannels });
+
+            for (auto index = next++; index < numResponses; index = next++)
+            {
+                const float* row = table + index * numParameterColumns;
+                engine.setParameters(makeParameters(row[roomSize], row[damping], row[wetLevel],
+                                                    row[dryLevel], row[width], row[freeze] >= 0.5f));
+                engine.reset();
+
+                std::array<float*, 2> channels {};
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    channels[(size_t) channel] = destination + (index * (size_t) numChannels + (size_t) channel) * (size_t) length;
+                    std::fill(channels[(size_t) channel], channels[(size_t) channel] + length, 0.f);
+                    channels[(size_t) channel][0] = 1.f;
+                }
+
+                processChannels(engine, channels.data(), channels.data(), numChannels, length, maxBlockSize);
+            }
+        };
+
+        std::vector<std::thread> threads;
+
+        for (int i = 1; i < juce::jmin(numThreads, (int) numResponses); ++i)
+            threads.emplace_back(worker);
+
+        worker();
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    return result;
+}
+
+} // namespace
+
+//==============================================================================
+PYBIND11_MODULE(basicreverb, m)
+{
+    m.doc() = "Reverb engines from the Basic Reverb plugin, processing NumPy float32 arrays in place";
+
+    py::enum_<ReverbEngine::Type>(m, "Engine")
+        .value("JUCE", ReverbEngine::Type::juce)
+        .value("FDN", ReverbEngine::Type::fdn)
+        .value("VELVET", ReverbEngine::Type::velvet);
+
+    py::enum_<FDNReverb::Quality>(m, "Quality")
+        .value("LOW", FDNReverb::Quality::low)
+        .value("MEDIUM", FDNReverb::Quality::medium)
+        .value("HIGH", FDNReverb::Quality::high);
+
+    py::class_<PythonReverb>(m, "Reverb")
+        .def(py::init<double, int, int, ReverbEngine::Type, FDNReverb::Quality>(),
+             py::arg("sample_rate") = 48000.0,
+             py::arg("max_block_size") = 4096,
+             py::arg("channels") = 2,
+             py::arg("engine") = ReverbEngine::Type::juce,
+             py::arg("quality") = FDNReverb::Quality::high)
+        .def("set_parameters", &PythonReverb::setParameters,
+             py::arg("room_size") = 0.3f,
+             py::arg("damping") = 0.3f,
+             py::arg("wet_level") = 1.f,
+             py::arg("dry_level") = 0.f,
+             py::arg("width") = 1.f,
+             py::arg("freeze") = false)
+        .def("reset", &PythonReverb::reset)
+        .def("process", &PythonReverb::process,
+             py::arg("input").noconvert(),
+             py::arg("output").noconvert() = py::none(),
+             "Processes a (channels, samples) float32 array, in place unless output is given.")
+        .def_property_readonly("sample_rate", &PythonReverb::getSampleRate)
+        .def_property_readonly("max_block_size", &PythonReverb::getMaxBlockSize)
+        .def_property_readonly("channels", &PythonReverb::getNumChannels);
+
+    m.def("render_impulse_responses", &renderImpulseResponses,
+          py::arg("parameters").noconvert(),
+          py::arg("engine") = ReverbEngine::Type::juce,
+          py::arg("quality") = FDNReverb::Quality::high,
+          py::arg("sample_rate") = 48000.0,
+          py::arg("length") = 96000,
+          py::arg("channels") = 2,
+          py::arg("max_block_size") = 4096,
+          py::arg("threads") = 0,
+          "Renders one impulse response per row of a (n, 6) float32 table of\n"
+          "room_size, damping, wet_level, dry_level, width, freeze. Returns (n, channels, length).");
+}
@@ -0,0 +1,91 @@
+"""Checks that the bindings process NumPy arrays without copying and that a
+threaded batch render matches rendering one response at a time."""
+
+import sys
+
+try:
+    import numpy as np
+except ImportError:
+    print("numpy is not installed")
+    sys.exit(77)
+
+import basicreverb
+
+
+def impulse(channels, length):
+    x = np.zeros((channels, length), dtype=np.float32)
+    x[:, 0] = 1.0
+    return x
+
+
+def check_in_place():
+    reverb = basicreverb.Reverb(sample_rate=48000, max_block_size=512, channels=2)
+    reverb.set_parameters(room_size=0.5)
+
+    # A C-contiguous view into a larger buffer: a copy would leave the buffer as it was, and writing past
+    # the view would touch the guard samples after it.
+    buffer = np.zeros(2 * 48000 + 64, dtype=np.float32)
+    x = buffer[: 2 * 48000].reshape(2, 48000)
+    x[:, 0] = 1.0
+    assert np.shares_memory(x, buffer)
+
+    assert reverb.process(x) is None
+    assert np.abs(buffer[1000:48000]).max() > 0.0, "nothing was written into the first channel"
+    assert np.abs(buffer[48000 + 1000 : 2 * 48000]).max() > 0.0, "nothing was written into the second channel"
+    assert not buffer[2 * 48000 :].any(), "wrote past the end of the array"
+
+    # A zero length block is a no-op, not an IndexError.
+    reverb.process(np.zeros((2, 0), dtype=np.float32))
+
+
+def check_out_of_place():
+    reverb = basicreverb.Reverb(engine=basicreverb.Engine.VELVET)
+    x = impulse(2, 4800)
+    y = np.empty_like(x)
+    reverb.process(x, y)
+    assert x[0, 0] == 1.0 and not x[:, 1:].any(), "input was modified"
+    assert np.abs(y[:, 1:]).max() > 0.0
+
+
+def check_no_silent_copies():
+    reverb = basicreverb.Reverb()
+    for bad in (np.zeros((2, 64)),                                  # float64
+                np.zeros((64, 2), dtype=np.float32).T):              # not C-contiguous
+        try:
+            reverb.process(bad)
+        except TypeError:
+            continue
+        raise AssertionError("expected TypeError for a layout that would need a copy")
+
+
+def check_batch_matches_single():
+    # More rows than threads, so every worker renders several rows with the same engine and any
+    # state left over from the row before shows up as a mismatch.
+    table = np.array([[0.2, 0.5, 1.0, 0.0, 1.0, 0.0],
+                      [0.8, 0.1, 1.0, 0.0, 1.0, 0.0],
+                      [0.5, 0.9, 0.5, 0.5, 0.5, 0.0],
+                      [0.1, 0.0, 0.3, 1.0, 0.0, 0.0],
+                      [0.9, 0.7, 1.0, 0.0, 1.0, 0.0],
+                      [0.3, 0.3, 0.8, 0.2, 0.7, 0.0],
+                      [0.6, 1.0, 1.0, 0.0, 0.2, 0.0],
+                      [0.4, 0.2, 0.6, 0.4, 1.0, 0.0]], dtype=np.float32)
+
+    for engine in (basicreverb.Engine.JUCE, basicreverb.Engine.FDN, basicreverb.Engine.VELVET):
+        batch = basicreverb.render_impulse_responses(table, engine=engine, length=24000, threads=3)
+        assert batch.shape == (len(table), 2, 24000) and batch.dtype == np.float32
+
+        for row, expected in zip(table, batch):
+            reverb = basicreverb.Reverb(engine=engine)
+            reverb.set_parameters(*row[:5], freeze=bool(row[5]))
+            reverb.reset()  # start the smoothers at the new parameters, as the batch does
+            x = impulse(2, 24000)
+            reverb.process(x)
+            np.testing.assert_array_equal(x, expected)
+
+
+if __name__ == "__main__":
+    check_in_place()
+    check_out_of_place()
+    check_no_silent_copies()
+    check_batch_matches_single()
+    print("ok")
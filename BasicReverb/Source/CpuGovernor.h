@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    CpuGovernor.h
+    Created: 19 Oct 2026 11:26:52am
+    Author:  Ryan Baker
+
+    Picks the FDN quality from the measured load of processBlock. The load is
+    the block's processing time as a proportion of the block's deadline
+    (block size / sample rate), as measured by juce::AudioProcessLoadMeasurer.
+
+    Quality drops one step as soon as the load stays over budget for a few
+    blocks, and only climbs back after it has stayed well under budget for a
+    couple of seconds. A degraded reverb is always better than an xrun.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "FDNReverb.h"
+
+class CpuGovernor
+{
+public:
+    CpuGovernor() = default;
+
+    void prepare(double newSampleRate, int maximumBlockSize)
+    {
+        sampleRate = newSampleRate;
+        blockSize = maximumBlockSize;
+        loadMeasurer.reset(sampleRate, blockSize);
+        quality = maximumQuality;
+        overBudgetBlocks = 0;
+        samplesUnderBudget = 0;
+        samplesUntilNextDecision = 0;
+    }
+
+    void setBudget(float maxCpuPercent) noexcept { budget = maxCpuPercent * 0.01f; }
+    void setMaximumQuality(FDNReverb::Quality newMaximum) noexcept { maximumQuality = newMaximum; }
+
+    // Call once at the start of each block, before the ScopedTimer for that block. Returns the
+    // quality the engine should run at.
+    FDNReverb::Quality update(int numSamples) noexcept
+    {
+        return update(numSamples, (float) loadMeasurer.getLoadAsProportion());
+    }
+
+    // The decision on its own, for a given load of the previous blocks.
+    FDNReverb::Quality update(int numSamples, float load) noexcept
+    {
+        if (quality > maximumQuality)
+            return changeQuality(maximumQuality);
+
+        // Give the measurement time to settle after a change, including the crossfade, during
+        // which both networks are running.
+        if (samplesUntilNextDecision > 0)
+        {
+            samplesUntilNextDecision -= numSamples;
+            return quality;
+        }
+
+        // Both counters stop at their thresholds, so they can't overflow however long a session
+        // stays at one quality.
+        const auto upgradeDelaySamples = (int) (upgradeDelaySeconds * sampleRate);
+
+        if (load > budget)
+        {
+            samplesUnderBudget = 0;
+            overBudgetBlocks = juce::jmin(overBudgetBlocks + 1, blocksBeforeDowngrade);
+
+            if (overBudgetBlocks >= blocksBeforeDowngrade && quality > FDNReverb::Quality::low)
+                return changeQuality(static_cast<FDNReverb::Quality>(static_cast<int>(quality) - 1));
+        }
+        else
+        {
+            overBudgetBlocks = 0;
+            samplesUnderBudget = load < budget * 0.5f ? juce::jmin(samplesUnderBudget + numSamples, upgradeDelaySamples) : 0;
+
+            if (samplesUnderBudget >= upgradeDelaySamples && quality < maximumQuality)
+                return changeQuality(static_cast<FDNReverb::Quality>(static_cast<int>(quality) + 1));
+        }
+
+        return quality;
+    }
+
+    FDNReverb::Quality getQuality() const noexcept { return quality; }
+
+    juce::AudioProcessLoadMeasurer loadMeasurer;
+
+private:
+    FDNReverb::Quality changeQuality(FDNReverb::Quality newQuality) noexcept
+    {
+        quality = newQuality;
+        overBudgetBlocks = 0;
+        samplesUnderBudget = 0;
+        samplesUntilNextDecision = (int) (settleSeconds * sampleRate);
+        loadMeasurer.reset(sampleRate, blockSize);
+        return quality;
+    }
+
+    static constexpr int blocksBeforeDowngrade = 4;
+    static constexpr double upgradeDelaySeconds = 2.0;
+    static constexpr double settleSeconds = 0.5;
+
+    double sampleRate = 44100.0;
+    int blockSize = 512;
+    float budget = 0.5f;
+
+    FDNReverb::Quality maximumQuality = FDNReverb::Quality::high;
+    FDNReverb::Quality quality = FDNReverb::Quality::high;
+
+    int overBudgetBlocks = 0;
+    int samplesUnderBudget = 0;
+    int samplesUntilNextDecision = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CpuGovernor)
+};
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    EngineCommon.h
+    Created: 20 Oct 2026 11:02:37am
+    Author:  Ryan Baker
+
+    What the FDN and velvet engines share: the level scaling of
+    juce::dsp::Reverb, so the mix knobs mean the same on every engine, the
+    smoothed wet/dry/width mix at the end of each engine, and the plumbing
+    from a ProcessContext to an engine's mono and stereo loops.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Same scaling as juce::dsp::Reverb, so switching engines keeps the levels of the mix knobs.
+constexpr float wetScaleFactor = 3.f;
+constexpr float dryScaleFactor = 2.f;
+
+inline bool isFrozen(float freezeMode) noexcept { return freezeMode >= 0.5f; }
+
+inline float onePoleCoefficient(float cutoffHz, double sampleRate) noexcept
+{
+    return 1.f - std::exp(-juce::MathConstants<float>::twoPi
+                          * juce::jmin(cutoffHz, 0.45f * (float) sampleRate) / (float) sampleRate);
+}
+
+//==============================================================================
+// The dry level and the two wet gains that spread the stereo width, smoothed as juce::dsp::Reverb
+// smooths them.
+class EngineMix
+{
+public:
+    EngineMix() = default;
+
+    void prepare(double sampleRate)
+    {
+        dryGain.reset(sampleRate, 0.01);
+        wetGain1.reset(sampleRate, 0.01);
+        wetGain2.reset(sampleRate, 0.01);
+    }
+
+    void setParameters(const juce::dsp::Reverb::Parameters& params) noexcept
+    {
+        const float wet = params.wetLevel * wetScaleFactor;
+
+        dryGain.setTargetValue(params.dryLevel * dryScaleFactor);
+        wetGain1.setTargetValue(0.5f * wet * (1.f + params.width));
+        wetGain2.setTargetValue(0.5f * wet * (1.f - params.width));
+    }
+
+    // Jumps to the targets, for a reset.
+    void snap() noexcept
+    {
+        dryGain.setCurrentAndTargetValue(dryGain.getTargetValue());
+        wetGain1.setCurrentAndTargetValue(wetGain1.getTargetValue());
+        wetGain2.setCurrentAndTargetValue(wetGain2.getTargetValue());
+    }
+
+    float mixMono(float dry, float wetLeft, float wetRight) noexcept
+    {
+        return 0.5f * (wetLeft + wetRight) * wetGain1.getNextValue() + dry * dryGain.getNextValue();
+    }
+
+    void mixStereo(float dryLeft, float dryRight, float wetLeft, float wetRight, float& left, float& right) noexcept
+    {
+        const float dry = dryGain.getNextValue();
+        const float wet1 = wetGain1.getNextValue();
+        const float wet2 = wetGain2.getNextValue();
+
+        left  = wetLeft * wet1 + wetRight * wet2 + dryLeft * dry;
+        right = wetRight * wet1 + wetLeft * wet2 + dryRight * dry;
+    }
+
+private:
+    juce::SmoothedValue<float> dryGain, wetGain1, wetGain2;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineMix)
+};
+
+//==============================================================================
+// Runs a ProcessContext through an engine's processMono or processStereo, the way
+// juce::dsp::Reverb::process does, except that the engine reads the input block itself instead of
+// a copy of it in the output block. Each loop reads a sample before it writes that sample's output,
+// so the two blocks may also be the same.
+template <typename Engine, typename ProcessContext>
+void processEngine(Engine& engine, const ProcessContext& context) noexcept
+{
+    const auto& inputBlock = context.getInputBlock();
+    auto& outputBlock      = context.getOutputBlock();
+    const auto numInChannels  = inputBlock.getNumChannels();
+    const auto numOutChannels = outputBlock.getNumChannels();
+    const auto numSamples     = outputBlock.getNumSamples();
+
+    jassert(inputBlock.getNumSamples() == numSamples);
+
+    if (context.isBypassed)
+    {
+        if (context.usesSeparateInputAndOutputBlocks())
+            outputBlock.copyFrom(inputBlock);
+
+        return;
+    }
+
+    if (numInChannels == 1 && numOutChannels == 1)
+        engine.processMono(inputBlock.getChannelPointer(0), outputBlock.getChannelPointer(0), (int) numSamples);
+    else if (numInChannels == 2 && numOutChannels == 2)
+        engine.processStereo(inputBlock.getChannelPointer(0), inputBlock.getChannelPointer(1),
+                             outputBlock.getChannelPointer(0), outputBlock.getChannelPointer(1), (int) numSamples);
+    else
+        jassertfalse; // invalid channel configuration
+}
@@ -0,0 +1,360 @@
+/*
+  ==============================================================================
+
+    FDNReverb.cpp
+    Created: 19 Oct 2026 10:41:03am
+    Author:  Ryan Baker
+
+  ==============================================================================
+*/
+
+#include "FDNReverb.h"
+#include "EngineCommon.h"
+#include "ReverbTime.h"
+
+namespace {
+
+// Mutually distant line lengths in milliseconds at room size 0.5. Smaller networks take every
+// second or fourth entry so they still cover the whole range.
+constexpr std::array<float, FDNReverb::maxNumLines> delayTimesMs
+{
+    19.3f, 21.7f, 23.9f, 26.3f, 28.9f, 31.3f, 34.1f, 37.1f,
+    40.3f, 43.7f, 47.3f, 51.1f, 55.3f, 59.9f, 64.7f, 69.9f
+};
+
+constexpr float maxSizeScale        = 1.5f;
+constexpr float modulationDepthMs   = 0.25f;
+constexpr float lowCrossoverHz      = 250.f;
+constexpr float highCrossoverHz     = 4000.f;
+constexpr float crossfadeSeconds    = 0.3f;
+constexpr float outputGain          = 0.5f;
+
+float roomSizeToSizeScale(float roomSize) noexcept { return 0.5f + roomSize; }
+
+float decayGain(float delaySamples, float rt60, double sampleRate) noexcept
+{
+    return std::pow(10.f, -3.f * delaySamples / (rt60 * (float) sampleRate));
+}
+
+// Unnormalised fast Walsh-Hadamard transform, numLines must be a power of two.
+void hadamard(float* x, int numLines) noexcept
+{
+    for (int span = 1; span < numLines; span *= 2)
+        for (int start = 0; start < numLines; start += span * 2)
+            for (int i = start; i < start + span; ++i)
+            {
+                const float a = x[i], b = x[i + span];
+                x[i] = a + b;
+                x[i + span] = a - b;
+            }
+}
+
+} // namespace
+
+//==============================================================================
+FDNReverb::Configuration FDNReverb::getConfiguration(Quality forQuality)
+{
+    switch (forQuality)
+    {
+        case Quality::low:    return { 4,  Interpolation::none,        2 };
+        case Quality::medium: return { 8,  Interpolation::linear,      2 };
+        case Quality::high:   break;
+    }
+
+    return { 16, Interpolation::lagrange3rd, 3 };
+}
+
+void FDNReverb::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+
+    const auto maxDelaySamples = (int) std::ceil((delayTimesMs.back() * maxSizeScale + 2.f * modulationDepthMs)
+                                                 * 0.001 * sampleRate) + 4;
+
+    for (auto& network : networks)
+        network.allocate(maxDelaySamples);
+
+    networks[(size_t) activeNetwork].configure(getConfiguration(quality), sampleRate);
+    crossfadeIncrement = 1.f / (crossfadeSeconds * (float) sampleRate);
+
+    sizeScale.reset(sampleRate, 0.05);
+    mix.prepare(sampleRate);
+
+    reset();
+}
+
+void FDNReverb::reset()
+{
+    for (auto& network : networks)
+        network.reset();
+
+    crossfadePosition = 1.f;
+
+    sizeScale.setCurrentAndTargetValue(roomSizeToSizeScale(params.roomSize));
+    mix.setParameters(params);
+    mix.snap();
+
+    networks[(size_t) activeNetwork].updateDecay(params, sizeScale.getTargetValue(), sampleRate);
+}
+
+void FDNReverb::resetWithQuality(Quality newQuality)
+{
+    quality = newQuality;
+    networks[(size_t) activeNetwork].configure(getConfiguration(quality), sampleRate);
+
+    reset();
+}
+
+void FDNReverb::setParameters(const juce::dsp::Reverb::Parameters& newParams)
+{
+    params = newParams;
+
+    sizeScale.setTargetValue(roomSizeToSizeScale(params.roomSize));
+    mix.setParameters(params);
+
+    // The idle network gets its decay when setQuality configures it.
+    networks[(size_t) activeNetwork].updateDecay(params, sizeScale.getTargetValue(), sampleRate);
+
+    if (isCrossfading())
+        networks[(size_t) (1 - activeNetwork)].updateDecay(params, sizeScale.getTargetValue(), sampleRate);
+}
+
+void FDNReverb::setQuality(Quality newQuality)
+{
+    if (newQuality == quality || isCrossfading())
+        return;
+
+    const int nextNetwork = 1 - activeNetwork;
+    auto& network = networks[(size_t) nextNetwork];
+
+    // The idle network was cleared when it was last faded out, so it only needs configuring. This
+    // runs when the governor has just seen an overload, so it mustn't add a pass over the memory.
+    network.configure(getConfiguration(newQuality), sampleRate);
+    network.updateDecay(params, sizeScale.getTargetValue(), sampleRate);
+
+    activeNetwork = nextNetwork;
+    quality = newQuality;
+    crossfadePosition = 0.f;
+}
+
+//==============================================================================
+void FDNReverb::processFrame(float inLeft, float inRight, float& wetLeft, float& wetRight) noexcept
+{
+    const float input = 0.5f * (inLeft + inRight);
+    const float scale = sizeScale.getNextValue();
+
+    networks[(size_t) activeNetwork].processSample(input, scale, wetLeft, wetRight);
+
+    if (isCrossfading())
+    {
+        // The two networks are uncorrelated, so an equal power fade keeps the level steady.
+        float oldLeft, oldRight;
+        networks[(size_t) (1 - activeNetwork)].processSample(input, scale, oldLeft, oldRight);
+
+        const float angle = crossfadePosition * juce::MathConstants<float>::halfPi;
+        const float fadeIn = std::sin(angle), fadeOut = std::cos(angle);
+
+        wetLeft  = wetLeft  * fadeIn + oldLeft  * fadeOut;
+        wetRight = wetRight * fadeIn + oldRight * fadeOut;
+
+        crossfadePosition = juce::jmin(1.f, crossfadePosition + crossfadeIncrement);
+
+        // Clear the network that has just faded out now, while there's no overload to handle, so
+        // the next switch to it costs nothing extra.
+        if (! isCrossfading())
+            networks[(size_t) (1 - activeNetwork)].clear();
+    }
+}
+
+void FDNReverb::processMono(const float* input, float* output, int numSamples) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float wetLeft, wetRight;
+        processFrame(input[i], input[i], wetLeft, wetRight);
+
+        output[i] = mix.mixMono(input[i], wetLeft, wetRight);
+    }
+}
+
+void FDNReverb::processStereo(const float* inLeft, const float* inRight, float* outLeft, float* outRight, int numSamples) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float wetLeft, wetRight;
+        processFrame(inLeft[i], inRight[i], wetLeft, wetRight);
+        mix.mixStereo(inLeft[i], inRight[i], wetLeft, wetRight, outLeft[i], outRight[i]);
+    }
+}
+
+//==============================================================================
+void FDNReverb::Network::allocate(int maxDelaySamples)
+{
+    bufferLength = (int) juce::nextPowerOfTwo(maxDelaySamples);
+    mask = bufferLength - 1;
+    memory.assign((size_t) (bufferLength * maxNumLines), 0.f);
+}
+
+void FDNReverb::Network::configure(const Configuration& newConfig, double sampleRate)
+{
+    jassert(juce::isPowerOfTwo(newConfig.numLines) && newConfig.numLines <= maxNumLines);
+
+    config = newConfig;
+
+    const int stride = maxNumLines / config.numLines;
+    const float samplesPerMs = (float) sampleRate * 0.001f;
+
+    for (int line = 0; line < config.numLines; ++line)
+    {
+        baseDelay[(size_t) line] = delayTimesMs[(size_t) (line * stride)] * samplesPerMs;
+        lfoIncrement[(size_t) line] = (0.1f + 0.05f * (float) (line * stride)) / (float) sampleRate;
+    }
+
+    restartModulation();
+    modulationDepth = config.interpolation == Interpolation::none ? 0.f : modulationDepthMs * samplesPerMs;
+    lowCoefficient  = onePoleCoefficient(lowCrossoverHz, sampleRate);
+    highCoefficient = onePoleCoefficient(highCrossoverHz, sampleRate);
+}
+
+void FDNReverb::Network::clear() noexcept
+{
+    std::fill(memory.begin(), memory.begin() + bufferLength * config.numLines, 0.f);
+    lowState.fill(0.f);
+    highState.fill(0.f);
+    writeIndex = 0;
+}
+
+void FDNReverb::Network::restartModulation() noexcept
+{
+    // Spread evenly around the cycle, so a reset network renders the same impulse response as a
+    // freshly configured one.
+    for (int line = 0; line < config.numLines; ++line)
+        lfoPhase[(size_t) line] = (float) line / (float) config.numLines;
+}
+
+void FDNReverb::Network::reset() noexcept
+{
+    clear();
+    restartModulation();
+}
+
+void FDNReverb::Network::updateDecay(const juce::dsp::Reverb::Parameters& params, float sizeScale,
+                                     double sampleRate) noexcept
+{
+    const bool frozen = isFrozen(params.freezeMode);
+    const float rt60 = roomSizeToRT60(params.roomSize);
+    const float lowRT60 = config.numBands > 2 ? rt60 * 1.25f : rt60;
+    const float highRT60 = rt60 * (1.f - 0.85f * params.damping);
+
+    // Split the input across the lines so the level doesn't depend on the network size.
+    inputGain = frozen ? 0.f : 1.f / std::sqrt((float) config.numLines);
+
+    for (int line = 0; line < config.numLines; ++line)
+    {
+        const float delaySamples = baseDelay[(size_t) line] * sizeScale;
+        const float mid = frozen ? 1.f : decayGain(delaySamples, rt60, sampleRate);
+
+        midGain[(size_t) line]   = mid;
+        lowGain[(size_t) line]   = frozen ? 1.f : decayGain(delaySamples, lowRT60, sampleRate);
+        highRatio[(size_t) line] = frozen ? 1.f : decayGain(delaySamples, highRT60, sampleRate) / mid;
+    }
+}
+
+void FDNReverb::Network::processSample(float input, float sizeScale, float& outLeft, float& outRight) noexcept
+{
+    std::array<float, maxNumLines> lineOut;
+    const int numLines = config.numLines;
+    outLeft = outRight = 0.f;
+
+    for (int line = 0; line < numLines; ++line)
+    {
+        const float* buffer = memory.data() + line * bufferLength;
+
+        auto& phase = lfoPhase[(size_t) line];
+        phase += lfoIncrement[(size_t) line];
+        phase -= (float) (int) phase;
+
+        const float triangle = 4.f * std::abs(phase - 0.5f) - 1.f;
+        const float delay = baseDelay[(size_t) line] * sizeScale + modulationDepth * (1.f + triangle);
+        float y;
+
+        switch (config.interpolation)
+        {
+            case Interpolation::none:
+            {
+                y = buffer[(writeIndex - juce::roundToInt(delay)) & mask];
+                break;
+            }
+            case Interpolation::linear:
+            {
+                const int delayInt = (int) delay;
+                const float frac = delay - (float) delayInt;
+                const float a = buffer[(writeIndex - delayInt) & mask];
+                const float b = buffer[(writeIndex - delayInt - 1) & mask];
+                y = a + frac * (b - a);
+                break;
+            }
+            case Interpolation::lagrange3rd:
+            default:
+            {
+                // Same formulation as juce::dsp::DelayLine: the fraction is kept in [1, 2) so the
+                // four taps sit either side of the read position.
+                const int delayInt = (int) delay - 1;
+                const float frac = delay - (float) delayInt;
+                const float value1 = buffer[(writeIndex - delayInt) & mask];
+                const float value2 = buffer[(writeIndex - delayInt - 1) & mask];
+                const float value3 = buffer[(writeIndex - delayInt - 2) & mask];
+                const float value4 = buffer[(writeIndex - delayInt - 3) & mask];
+
+                const float d1 = frac - 1.f, d2 = frac - 2.f, d3 = frac - 3.f;
+                const float c1 = -d1 * d2 * d3 / 6.f;
+                const float c2 = d2 * d3 * 0.5f;
+                const float c3 = -d1 * d3 * 0.5f;
+                const float c4 = d1 * d2 / 6.f;
+
+                y = value1 * c1 + frac * (value2 * c2 + value3 * c3 + value4 * c4);
+                break;
+            }
+        }
+
+        // Frequency dependent decay as a cascade of first order shelves. Each shelf is monotonic
+        // between its DC and Nyquist gains, so the loop gain never exceeds the largest band gain.
+        if (config.numBands > 2)
+        {
+            auto& low = lowState[(size_t) line];
+            low += lowCoefficient * (y - low);
+            y = midGain[(size_t) line] * y + (lowGain[(size_t) line] - midGain[(size_t) line]) * low;
+        }
+        else
+        {
+            y *= midGain[(size_t) line];
+        }
+
+        auto& high = highState[(size_t) line];
+        high += highCoefficient * (y - high);
+        y = high + highRatio[(size_t) line] * (y - high);
+
+        lineOut[(size_t) line] = y;
+
+        // Even lines feed the left output and odd lines the right, with alternating signs.
+        const float tap = (line & 2) != 0 ? -y : y;
+        if ((line & 1) == 0)
+            outLeft += tap;
+        else
+            outRight += tap;
+    }
+
+    hadamard(lineOut.data(), numLines);
+
+    const float normalise = 1.f / std::sqrt((float) numLines);
+
+    for (int line = 0; line < numLines; ++line)
+    {
+        const float injected = (line & 2) != 0 ? -input : input;
+        memory[(size_t) (line * bufferLength + writeIndex)] = lineOut[(size_t) line] * normalise + injected * inputGain;
+    }
+
+    writeIndex = (writeIndex + 1) & mask;
+    outLeft *= outputGain;
+    outRight *= outputGain;
+}
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    FDNReverb.h
+    Created: 19 Oct 2026 10:41:03am
+    Author:  Ryan Baker
+
+    Feedback delay network reverb with a Hadamard feedback matrix and
+    frequency dependent decay per line (see FDN Block Diagrams/FDN.png).
+
+    It takes the same parameters as juce::dsp::Reverb so the two can be swapped
+    behind the same parameter set. The network can run with 16, 8 or 4 lines;
+    changing the quality crossfades from the running network to a second,
+    pre-allocated one that is kept cleared, so the switch neither allocates
+    nor has to zero any memory on the audio thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "EngineCommon.h"
+
+class FDNReverb
+{
+public:
+    enum class Quality { low = 0, medium, high };
+
+    enum class Interpolation { none, linear, lagrange3rd };
+
+    struct Configuration
+    {
+        int numLines;
+        Interpolation interpolation;
+        int numBands; // 2 = mid/high decay, 3 = low/mid/high decay
+    };
+
+    static constexpr int maxNumLines = 16;
+
+    static Configuration getConfiguration(Quality forQuality);
+
+    //==============================================================================
+    FDNReverb() = default;
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    // Resets straight into the new quality, with no crossfade and whether or not one is running.
+    // This zeroes the whole network, so it is for setting up an engine, not for the audio thread.
+    void resetWithQuality(Quality newQuality);
+
+    void setParameters(const juce::dsp::Reverb::Parameters& newParams);
+    const juce::dsp::Reverb::Parameters& getParameters() const noexcept { return params; }
+
+    // Starts a crossfade to the network for the new quality. Requests that arrive while a crossfade
+    // is still running are ignored; the caller will ask again on a later block.
+    void setQuality(Quality newQuality);
+    Quality getQuality() const noexcept { return quality; }
+    bool isCrossfading() const noexcept { return crossfadePosition < 1.f; }
+
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept { processEngine(*this, context); }
+
+    void processMono(const float* input, float* output, int numSamples) noexcept;
+    void processStereo(const float* inLeft, const float* inRight, float* outLeft, float* outRight, int numSamples) noexcept;
+
+private:
+    struct Network
+    {
+        void allocate(int maxDelaySamples);
+        void configure(const Configuration& newConfig, double sampleRate);
+
+        // Zeroes the delay lines and filters. The network that isn't running is always kept clear.
+        void clear() noexcept;
+        void restartModulation() noexcept;
+        void reset() noexcept;
+        void updateDecay(const juce::dsp::Reverb::Parameters& params, float sizeScale, double sampleRate) noexcept;
+        void processSample(float input, float sizeScale, float& outLeft, float& outRight) noexcept;
+
+        Configuration config { 16, Interpolation::lagrange3rd, 3 };
+        std::vector<float> memory;
+        int bufferLength = 0, mask = 0, writeIndex = 0;
+        float modulationDepth = 0.f;
+        float inputGain = 0.f;
+
+        std::array<float, maxNumLines> baseDelay {}, lfoPhase {}, lfoIncrement {};
+        std::array<float, maxNumLines> lowState {}, highState {};
+        std::array<float, maxNumLines> lowGain {}, midGain {}, highRatio {};
+        float lowCoefficient = 0.f, highCoefficient = 0.f;
+    };
+
+    void processFrame(float inLeft, float inRight, float& wetLeft, float& wetRight) noexcept;
+
+    juce::dsp::Reverb::Parameters params; // defaults as in juce::dsp::Reverb
+    std::array<Network, 2> networks;
+    int activeNetwork = 0;
+    Quality quality = Quality::high;
+
+    double sampleRate = 44100.0;
+    float crossfadePosition = 1.f, crossfadeIncrement = 0.f;
+
+    juce::SmoothedValue<float> sizeScale;
+    EngineMix mix;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FDNReverb)
+};
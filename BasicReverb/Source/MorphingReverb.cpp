@@ -0,0 +1,262 @@
+/*
+  ==============================================================================
+
+    MorphingReverb.cpp
+    Created: 19 Oct 2026 7:02:48pm
+    Author:  Ryan Baker
+
+  ==============================================================================
+*/
+
+#include "MorphingReverb.h"
+
+namespace {
+
+// How fast room size and damping may move on the running engine, in full ranges per second. Each
+// block's step is small enough for the engines' own smoothing to hide.
+constexpr float maxGlidePerSecond = 2.f;
+
+// How often the worker looks for a morph request while instances exist, which bounds how late a
+// morph starts.
+constexpr int workerPollMs = 5;
+
+void applyConfiguration(ReverbEngine& engine, const MorphingReverb::Configuration& configuration)
+{
+    engine.setType(configuration.type);
+    engine.setParameters(configuration.parameters);
+}
+
+float glideTowards(float current, float target, float maxStep) noexcept
+{
+    return current + juce::jlimit(-maxStep, maxStep, target - current);
+}
+
+bool sameParameters(const juce::dsp::Reverb::Parameters& a, const juce::dsp::Reverb::Parameters& b) noexcept
+{
+    return a.roomSize == b.roomSize && a.damping == b.damping && a.wetLevel == b.wetLevel
+        && a.dryLevel == b.dryLevel && a.width == b.width && a.freezeMode == b.freezeMode;
+}
+
+} // namespace
+
+//==============================================================================
+// The one background thread behind every MorphingReverb in the process. It polls a request flag
+// rather than waiting to be woken, because waking it would mean the audio thread taking a lock,
+// and it only takes its own lock and visits the instances once some instance has asked. With no
+// instances it sleeps until one is added.
+class MorphingReverb::Worker : private juce::Thread
+{
+public:
+    Worker() : juce::Thread("Reverb morph") { startThread(); }
+    ~Worker() override { stopThread(1000); }
+
+    void add(MorphingReverb& reverb)
+    {
+        {
+            const juce::ScopedLock sl(lock);
+            reverbs.addIfNotAlreadyThere(&reverb);
+            numReverbs.store(reverbs.size());
+        }
+
+        notify();
+    }
+
+    // Once this returns, the worker is not touching the instance and won't again until it is added.
+    void remove(MorphingReverb& reverb)
+    {
+        const juce::ScopedLock sl(lock);
+        reverbs.removeFirstMatchingValue(&reverb);
+        numReverbs.store(reverbs.size());
+    }
+
+    // Called by the audio thread once an instance is preparing: a store, no lock and no wake-up.
+    void requestService() noexcept { serviceRequested.store(true, std::memory_order_release); }
+
+private:
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            if (serviceRequested.exchange(false, std::memory_order_acquire))
+            {
+                const juce::ScopedLock sl(lock);
+
+                for (auto* reverb : reverbs)
+                    reverb->serviceStandby();
+            }
+
+            wait(numReverbs.load() > 0 ? workerPollMs : -1);
+        }
+    }
+
+    juce::CriticalSection lock;
+    juce::Array<MorphingReverb*> reverbs;
+    std::atomic<int> numReverbs { 0 };
+    std::atomic<bool> serviceRequested { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Worker)
+};
+
+//==============================================================================
+MorphingReverb::MorphingReverb() = default;
+
+MorphingReverb::~MorphingReverb()
+{
+    worker->remove(*this);
+}
+
+void MorphingReverb::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    // Nothing else touches the engines while the worker has let go of this instance.
+    worker->remove(*this);
+
+    sampleRate = spec.sampleRate;
+    runningType = target.type;
+    glided = target.parameters;
+
+    for (auto& engine : engines)
+    {
+        engine.setQuality(quality);
+        applyConfiguration(engine, target);
+        engine.prepare(spec);
+    }
+
+    incomingBuffer.setSize((int) spec.numChannels, (int) spec.maximumBlockSize);
+    setMorphTime(morphSeconds);
+
+    state.store(State::idle);
+    morphQueued = false;
+
+    worker->add(*this);
+}
+
+void MorphingReverb::setMorphTime(float newSeconds) noexcept
+{
+    morphSeconds = newSeconds;
+    fadeIncrement = 1.f / juce::jmax(1.f, morphSeconds * (float) sampleRate);
+}
+
+void MorphingReverb::setConfiguration(const Configuration& newConfiguration, bool morph) noexcept
+{
+    // A parameter change, however big, glides in process() instead.
+    morphQueued = morphQueued || morph || newConfiguration.type != target.type;
+    target = newConfiguration;
+
+    startQueuedMorph();
+}
+
+void MorphingReverb::setQuality(FDNReverb::Quality newQuality) noexcept
+{
+    quality = newQuality;
+    engines[(size_t) active].setQuality(newQuality);
+}
+
+void MorphingReverb::startQueuedMorph() noexcept
+{
+    // A morph asked for during another one starts when that finishes.
+    if (! morphQueued || state.load(std::memory_order_acquire) != State::idle)
+        return;
+
+    morphQueued = false;
+    pending = target;
+    pendingQuality = quality;
+
+    if (nonRealtime)
+    {
+        prepareStandby();
+        state.store(State::ready, std::memory_order_release);
+        return;
+    }
+
+    // The worker picks this up on its next poll.
+    state.store(State::preparing, std::memory_order_release);
+    worker->requestService();
+}
+
+void MorphingReverb::glideRunningEngine(int numSamples) noexcept
+{
+    auto next = target.parameters;
+    const float maxStep = maxGlidePerSecond * (float) numSamples / (float) sampleRate;
+
+    next.roomSize = glideTowards(glided.roomSize, target.parameters.roomSize, maxStep);
+    next.damping = glideTowards(glided.damping, target.parameters.damping, maxStep);
+
+    if (sameParameters(next, glided))
+        return;
+
+    glided = next;
+    engines[(size_t) active].setParameters(glided);
+}
+
+//==============================================================================
+void MorphingReverb::serviceStandby()
+{
+    if (state.load(std::memory_order_acquire) != State::preparing)
+        return;
+
+    prepareStandby();
+    state.store(State::ready, std::memory_order_release);
+}
+
+void MorphingReverb::prepareStandby()
+{
+    auto& standby = engines[(size_t) (1 - active)];
+
+    // setQuality would only start a crossfade, and not even that while one is running.
+    applyConfiguration(standby, pending);
+    standby.resetWithQuality(pendingQuality);
+}
+
+//==============================================================================
+void MorphingReverb::process(const juce::dsp::AudioBlock<const float>& input, juce::dsp::AudioBlock<float>& output) noexcept
+{
+    const auto current = state.load(std::memory_order_acquire);
+
+    if (current == State::ready)
+    {
+        fadePosition = 0.f;
+        state.store(State::fading, std::memory_order_relaxed);
+    }
+    else if (current == State::idle)
+    {
+        glideRunningEngine((int) output.getNumSamples());
+    }
+
+    juce::dsp::ProcessContextNonReplacing<float> context(input, output);
+    engines[(size_t) active].process(context);
+
+    if (state.load(std::memory_order_relaxed) != State::fading)
+        return;
+
+    const auto numChannels = output.getNumChannels();
+    const auto numSamples = output.getNumSamples();
+
+    auto incoming = juce::dsp::AudioBlock<float>(incomingBuffer).getSubsetChannelBlock(0, numChannels)
+                                                                .getSubBlock(0, numSamples);
+    juce::dsp::ProcessContextNonReplacing<float> incomingContext(input, incoming);
+    engines[(size_t) (1 - active)].process(incomingContext);
+
+    // The two engines are uncorrelated, so an equal power fade keeps the level steady.
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        const float angle = fadePosition * juce::MathConstants<float>::halfPi;
+        const float fadeIn = std::sin(angle), fadeOut = std::cos(angle);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            output.setSample((int) channel, (int) i, output.getSample((int) channel, (int) i) * fadeOut
+                                                     + incoming.getSample((int) channel, (int) i) * fadeIn);
+
+        fadePosition = juce::jmin(1.f, fadePosition + fadeIncrement);
+    }
+
+    if (fadePosition >= 1.f)
+    {
+        // The new engine runs at the configuration it was set up with; the glide carries on from there.
+        active = 1 - active;
+        runningType = engines[(size_t) active].getType();
+        glided = pending.parameters;
+        state.store(State::idle, std::memory_order_release);
+
+        startQueuedMorph();
+    }
+}
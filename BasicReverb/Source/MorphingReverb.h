@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    MorphingReverb.h
+    Created: 19 Oct 2026 7:02:48pm
+    Author:  Ryan Baker
+
+    Two pre-allocated engines, one running and one standing by, so that an
+    engine switch or a preset change can be crossfaded instead of jumping.
+
+    Only a new engine type or an explicit morph (a preset recall) is
+    crossfaded. Everything else glides on the running engine, at a limited
+    rate however far it moves, so its tail carries on and a fast sweep never
+    turns into a chain of morphs that each cut the tail short.
+
+    The standby engine is set up by one background thread shared by every
+    instance in the process. The audio thread hands a morph over by storing
+    an atomic state and raising a flag that the worker polls, so it never
+    wakes a thread or takes a lock, and it only starts the crossfade once the
+    worker is done.
+    The audio thread never allocates or recalculates the standby engine.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ReverbEngine.h"
+
+class MorphingReverb
+{
+public:
+    struct Configuration
+    {
+        ReverbEngine::Type type = ReverbEngine::Type::juce;
+        juce::dsp::Reverb::Parameters parameters;
+    };
+
+    MorphingReverb();
+    ~MorphingReverb();
+
+    // Prepares both engines at the latest configuration, dropping any morph in progress.
+    void prepare(const juce::dsp::ProcessSpec& spec);
+
+    void setMorphTime(float newSeconds) noexcept;
+
+    // Offline, the standby engine is set up on the calling thread, so renders are repeatable.
+    void setNonRealtime(bool isNonRealtime) noexcept { nonRealtime = isNonRealtime; }
+
+    // Call from the audio thread (or before prepare). Set morph to crossfade even when only the
+    // parameters have changed.
+    void setConfiguration(const Configuration& newConfiguration, bool morph = false) noexcept;
+
+    // Only the FDN has more than one quality. Applies to the running engine, and to the standby
+    // engine the next time one is set up.
+    void setQuality(FDNReverb::Quality newQuality) noexcept;
+
+    ReverbEngine::Type getType() const noexcept { return runningType; }
+
+    // Renders the wet signal of the running engine, crossfaded with the incoming one during a morph.
+    void process(const juce::dsp::AudioBlock<const float>& input, juce::dsp::AudioBlock<float>& output) noexcept;
+
+private:
+    class Worker;
+
+    // idle -> preparing (audio thread) -> ready (worker) -> fading -> idle (audio thread)
+    enum class State { idle, preparing, ready, fading };
+
+    // Called by the worker, which holds its lock so this instance can't be prepared or destroyed.
+    void serviceStandby();
+    void prepareStandby();
+    void startQueuedMorph() noexcept;
+    void glideRunningEngine(int numSamples) noexcept;
+
+    juce::SharedResourcePointer<Worker> worker;
+
+    std::array<ReverbEngine, 2> engines;
+    int active = 0;
+    ReverbEngine::Type runningType = ReverbEngine::Type::juce;
+
+    std::atomic<State> state { State::idle };
+
+    // Audio thread only: the latest configuration asked for, whether a morph to it is waiting for
+    // the current one to finish, and the parameters the running engine has glided to so far.
+    Configuration target;
+    bool morphQueued = false;
+    juce::dsp::Reverb::Parameters glided;
+    FDNReverb::Quality quality = FDNReverb::Quality::high;
+
+    // Written by the audio thread before it moves to preparing, read by the worker.
+    Configuration pending;
+    FDNReverb::Quality pendingQuality = FDNReverb::Quality::high;
+
+    juce::AudioBuffer<float> incomingBuffer;
+    double sampleRate = 44100.0;
+    float morphSeconds = 0.5f;
+    float fadePosition = 0.f, fadeIncrement = 0.f;
+    bool nonRealtime = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MorphingReverb)
+};
@@ -0,0 +1,224 @@
+/*
+  ==============================================================================
+
+    OutputStage.cpp
+    Created: 19 Oct 2026 5:41:26pm
+    Author:  Ryan Baker
+
+  ==============================================================================
+*/
+
+#include "OutputStage.h"
+#include "EngineCommon.h"
+
+namespace {
+
+constexpr float peakAttackMs = 1.f;
+constexpr float rmsAttackMs  = 10.f;
+
+constexpr float gateRatio   = 4.f;  // 1:4 downward expansion under the threshold
+constexpr float gateRangeDb = 80.f;
+
+float smoothingCoefficient(float milliseconds, double sampleRate) noexcept
+{
+    return 1.f - std::exp(-1.f / (milliseconds * 0.001f * (float) sampleRate));
+}
+
+} // namespace
+
+//==============================================================================
+void OutputStage::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+
+    dryGain.reset(sampleRate, 0.01);
+    wetGain.reset(sampleRate, 0.01);
+    width.reset(sampleRate, 0.01);
+    outputGain.reset(sampleRate, 0.01);
+
+    updateCoefficients();
+    reset();
+}
+
+void OutputStage::reset()
+{
+    peak = Lanes::expand(0.f);
+    meanSquare = Lanes::expand(0.f);
+
+    dryGain.setCurrentAndTargetValue(dryGain.getTargetValue());
+    wetGain.setCurrentAndTargetValue(wetGain.getTargetValue());
+    width.setCurrentAndTargetValue(width.getTargetValue());
+    outputGain.setCurrentAndTargetValue(outputGain.getTargetValue());
+
+    mix = computeMix(0);
+}
+
+void OutputStage::setLevels(float newDryLevel, float newWetLevel)
+{
+    dryGain.setTargetValue(newDryLevel * dryScaleFactor);
+    wetGain.setTargetValue(newWetLevel);
+}
+
+void OutputStage::setWidth(float newWidth)
+{
+    width.setTargetValue(newWidth);
+}
+
+void OutputStage::setOutputGain(float newGainDb)
+{
+    outputGain.setTargetValue(juce::Decibels::decibelsToGain(newGainDb));
+}
+
+void OutputStage::setDucking(float thresholdDb, float depthDb, float releaseMs, Detector detector)
+{
+    ducking = { thresholdDb, releaseMs, detector };
+    duckDepthDb = depthDb;
+    updateCoefficients();
+}
+
+void OutputStage::setGate(float thresholdDb, float releaseMs, Detector detector)
+{
+    gate = { thresholdDb, releaseMs, detector };
+    updateCoefficients();
+}
+
+void OutputStage::updateCoefficients() noexcept
+{
+    // The dry lanes release at the ducking time and the wet lanes at the gate time.
+    auto perStage = [] (float dryValue, float wetValue)
+    {
+        alignas(sizeof(Lanes)) float values[Lanes::SIMDNumElements] {};
+        values[dryLeft] = values[dryRight] = dryValue;
+        values[wetLeft] = values[wetRight] = wetValue;
+        return Lanes::fromRawArray(values);
+    };
+
+    // Mean squares fall at twice the rate of the level in dB, so they get half the time.
+    peakAttack  = Lanes::expand(smoothingCoefficient(peakAttackMs, sampleRate));
+    rmsAttack   = Lanes::expand(smoothingCoefficient(0.5f * rmsAttackMs, sampleRate));
+    peakRelease = perStage(smoothingCoefficient(ducking.releaseMs, sampleRate),
+                           smoothingCoefficient(gate.releaseMs, sampleRate));
+    rmsRelease  = perStage(smoothingCoefficient(0.5f * ducking.releaseMs, sampleRate),
+                           smoothingCoefficient(0.5f * gate.releaseMs, sampleRate));
+}
+
+//==============================================================================
+void OutputStage::updateFollowers(const float* inputDryLeft, const float* inputDryRight,
+                                  const float* inputWetLeft, const float* inputWetRight, int numSamples) noexcept
+{
+    alignas(sizeof(Lanes)) float frame[Lanes::SIMDNumElements] {};
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        frame[dryLeft]  = inputDryLeft[i];
+        frame[dryRight] = inputDryRight[i];
+        frame[wetLeft]  = inputWetLeft[i];
+        frame[wetRight] = inputWetRight[i];
+
+        // Every follower attacks when its input is above it and releases otherwise.
+        const auto x = Lanes::fromRawArray(frame);
+        const auto rectified = Lanes::abs(x);
+        const auto squared = x * x;
+
+        peak += (peakRelease + ((peakAttack - peakRelease) & Lanes::greaterThan(rectified, peak))) * (rectified - peak);
+        meanSquare += (rmsRelease + ((rmsAttack - rmsRelease) & Lanes::greaterThan(squared, meanSquare))) * (squared - meanSquare);
+    }
+}
+
+float OutputStage::computeGain() noexcept
+{
+    alignas(sizeof(Lanes)) float peaks[Lanes::SIMDNumElements];
+    alignas(sizeof(Lanes)) float meanSquares[Lanes::SIMDNumElements];
+    peak.copyToRawArray(peaks);
+    meanSquare.copyToRawArray(meanSquares);
+
+    auto levelDb = [&] (const Stage& stage, int left, int right)
+    {
+        const float level = stage.detector == Detector::peak ? juce::jmax(peaks[left], peaks[right])
+                                                             : std::sqrt(juce::jmax(meanSquares[left], meanSquares[right]));
+        return juce::Decibels::gainToDecibels(level, -120.f);
+    };
+
+    float reductionDb = 0.f;
+
+    if (duckDepthDb > 0.f)
+        reductionDb += juce::jlimit(0.f, duckDepthDb, levelDb(ducking, dryLeft, dryRight) - ducking.thresholdDb);
+
+    if (gate.thresholdDb > gateOffDb)
+        reductionDb += juce::jlimit(0.f, gateRangeDb, (gate.thresholdDb - levelDb(gate, wetLeft, wetRight)) * (gateRatio - 1.f));
+
+    return juce::Decibels::decibelsToGain(-reductionDb);
+}
+
+OutputStage::Mix OutputStage::computeMix(int numSamples) noexcept
+{
+    // Mid/side width: mid + width * side on the left and mid - width * side on the right, which
+    // is the same matrix juce::dsp::Reverb uses.
+    const float output = outputGain.skip(numSamples);
+    const float wet = wetGain.skip(numSamples) * computeGain() * output;
+    const float newWidth = width.skip(numSamples);
+
+    return { dryGain.skip(numSamples) * output, 0.5f * wet * (1.f + newWidth), 0.5f * wet * (1.f - newWidth) };
+}
+
+void OutputStage::process(float* const* channels, const float* const* wet, int numChannels, int numSamples) noexcept
+{
+    jassert(numChannels == 1 || numChannels == 2);
+
+    const int right = numChannels > 1 ? 1 : 0;
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const int num = juce::jmin(chunkSize, numSamples - start);
+
+        float* outputLeft = channels[0] + start;
+        float* outputRight = channels[right] + start;
+        const float* inputWetLeft = wet[0] + start;
+        const float* inputWetRight = wet[right] + start;
+
+       #if BLOCK_PROFILING
+        const auto analysisStart = BlockProfiler::readCycleCounter();
+       #endif
+
+        updateFollowers(outputLeft, outputRight, inputWetLeft, inputWetRight, num);
+
+       #if BLOCK_PROFILING
+        analysisCycles += BlockProfiler::readCycleCounter() - analysisStart;
+       #endif
+
+        // Ramp every coefficient from the end of the last chunk to the end of this one.
+        const auto target = computeMix(num);
+        const float step = 1.f / (float) num;
+        const Mix delta { (target.dry - mix.dry) * step,
+                          (target.wetDirect - mix.wetDirect) * step,
+                          (target.wetCross - mix.wetCross) * step };
+
+        if (numChannels > 1)
+        {
+            for (int i = 0; i < num; ++i)
+            {
+                const float t = (float) (i + 1);
+                const float dry = mix.dry + t * delta.dry;
+                const float direct = mix.wetDirect + t * delta.wetDirect;
+                const float cross = mix.wetCross + t * delta.wetCross;
+
+                const float left = outputLeft[i] * dry + inputWetLeft[i] * direct + inputWetRight[i] * cross;
+                outputRight[i] = outputRight[i] * dry + inputWetRight[i] * direct + inputWetLeft[i] * cross;
+                outputLeft[i] = left;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < num; ++i)
+            {
+                const float t = (float) (i + 1);
+                const float dry = mix.dry + t * delta.dry;
+                const float wetScale = mix.wetDirect + mix.wetCross + t * (delta.wetDirect + delta.wetCross);
+
+                outputLeft[i] = outputLeft[i] * dry + inputWetLeft[i] * wetScale;
+            }
+        }
+
+        mix = target;
+    }
+}
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    OutputStage.h
+    Created: 19 Oct 2026 5:41:26pm
+    Author:  Ryan Baker
+
+    Everything after the engines, in one pass over the host buffer: ducking
+    the reverb under the dry signal, gating its tail, the mid/side width
+    matrix, the wet/dry mix and the output gain.
+
+    The buffer is worked through in short chunks that stay in cache. The
+    envelope followers run first, in one SIMD register with a lane each for
+    dry left/right and wet left/right and a peak and an RMS follower for
+    every lane. The mix then runs as a plain vectorisable loop, with every
+    gain folded into three coefficients per output that are ramped across
+    the chunk. Nothing is looked ahead, so there is no added latency.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "BlockProfiler.h"
+
+class OutputStage
+{
+public:
+    enum class Detector { peak = 0, rms };
+
+    OutputStage() = default;
+
+    void prepare(double newSampleRate);
+    void reset();
+
+    // Levels as the engines take them, so dry is scaled the same way as juce::dsp::Reverb.
+    void setLevels(float newDryLevel, float newWetLevel);
+
+    // 0 is a mono reverb, 1 keeps the engine's full stereo image.
+    void setWidth(float newWidth);
+    void setOutputGain(float newGainDb);
+
+    // Turns the wet signal down by up to depthDb when the dry signal is over the threshold.
+    // A depth of 0 dB turns ducking off.
+    void setDucking(float thresholdDb, float depthDb, float releaseMs, Detector detector);
+
+    // Expands the wet signal downwards when it falls under the threshold, steeply enough to act as
+    // a gate without chattering. A threshold at gateOffDb or below turns gating off.
+    void setGate(float thresholdDb, float releaseMs, Detector detector);
+
+    // Mixes the wet signal into the dry one in place. Mono or stereo.
+    void process(float* const* channels, const float* const* wet, int numChannels, int numSamples) noexcept;
+
+    static constexpr float gateOffDb = -90.f;
+
+   #if BLOCK_PROFILING
+    // Cycles spent in the envelope followers since the last call, so the profiler can show the
+    // analysis apart from the mix it is fused with.
+    juce::uint64 takeAnalysisCycles() noexcept { return std::exchange(analysisCycles, juce::uint64 {}); }
+   #endif
+
+private:
+    using Lanes = juce::dsp::SIMDRegister<float>;
+    static_assert(Lanes::SIMDNumElements >= 4, "needs one lane for each of the four followers");
+
+    enum Lane { dryLeft = 0, dryRight, wetLeft, wetRight };
+
+    struct Stage
+    {
+        float thresholdDb = 0.f;
+        float releaseMs = 100.f;
+        Detector detector = Detector::peak;
+    };
+
+    // What each output takes from its own dry channel, its own wet channel and the other wet channel.
+    struct Mix
+    {
+        float dry = 0.f, wetDirect = 0.f, wetCross = 0.f;
+    };
+
+    void updateCoefficients() noexcept;
+    void updateFollowers(const float* inputDryLeft, const float* inputDryRight,
+                         const float* inputWetLeft, const float* inputWetRight, int numSamples) noexcept;
+    float computeGain() noexcept;
+    Mix computeMix(int numSamples) noexcept;
+
+    static constexpr int chunkSize = 32;
+
+    double sampleRate = 44100.0;
+
+    Stage ducking, gate;
+    float duckDepthDb = 0.f;
+
+    // Follower state and per-lane coefficients.
+    Lanes peak, meanSquare;
+    Lanes peakAttack, peakRelease, rmsAttack, rmsRelease;
+
+    // The coefficients at the end of the last chunk, which the next one ramps from.
+    Mix mix;
+
+    juce::SmoothedValue<float> dryGain, wetGain, width, outputGain;
+
+   #if BLOCK_PROFILING
+    juce::uint64 analysisCycles = 0;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OutputStage)
+};
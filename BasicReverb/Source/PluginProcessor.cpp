@@ -27,9 +27,21 @@ TestProjectAudioProcessor::TestProjectAudioProcessor()
     castParameter(apvts, myParameterID::r_size, roomSizeParameter);
     castParameter(apvts, myParameterID::r_damping, dampingParameter);
     castParameter(apvts, myParameterID::r_wet, wetLevelParameter);
-    castParameter(apvts, myParameterID::r_damping, dryLevelParameter);
+    castParameter(apvts, myParameterID::r_dry, dryLevelParameter);
     castParameter(apvts, myParameterID::r_width, widthParameter);
     castParameter(apvts, myParameterID::r_freeze, freezeParameter);
+    castParameter(apvts, myParameterID::r_engine, engineParameter);
+    castParameter(apvts, myParameterID::r_quality, qualityParameter);
+    castParameter(apvts, myParameterID::r_maxcpu, maxCpuParameter);
+    castParameter(apvts, myParameterID::r_duckthreshold, duckThresholdParameter);
+    castParameter(apvts, myParameterID::r_duckdepth, duckDepthParameter);
+    castParameter(apvts, myParameterID::r_duckrelease, duckReleaseParameter);
+    castParameter(apvts, myParameterID::r_duckdetector, duckDetectorParameter);
+    castParameter(apvts, myParameterID::r_gatethreshold, gateThresholdParameter);
+    castParameter(apvts, myParameterID::r_gaterelease, gateReleaseParameter);
+    castParameter(apvts, myParameterID::r_gatedetector, gateDetectorParameter);
+    castParameter(apvts, myParameterID::r_output, outputGainParameter);
+    castParameter(apvts, myParameterID::r_morphtime, morphTimeParameter);
 }
 
 TestProjectAudioProcessor::~TestProjectAudioProcessor()
@@ -108,7 +120,19 @@ void TestProjectAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
     spec.maximumBlockSize = samplesPerBlock;
     spec.numChannels = getTotalNumInputChannels();
 
+    wetBuffer.setSize((int) spec.numChannels, samplesPerBlock);
+    outputStage.prepare(sampleRate);
+
+    // Set the parameters before preparing, so the engines start at them instead of ramping
+    // from their defaults.
+    update();
     reverb.prepare(spec);
+    outputStage.reset();
+    cpuGovernor.prepare(sampleRate, samplesPerBlock);
+
+   #if BLOCK_PROFILING
+    profiler.prepare(sampleRate);
+   #endif
 }
 
 void TestProjectAudioProcessor::releaseResources()
@@ -146,6 +170,15 @@ bool TestProjectAudioProcessor::isBusesLayoutSupported (const BusesLayout& layou
 void TestProjectAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+
+    // The governor decides from the load of the previous blocks, then this block is timed.
+    // Offline renders have no deadline, so they always run at the selected quality.
+    if (reverb.getType() == ReverbEngine::Type::fdn && ! isNonRealtime())
+        reverb.setQuality(cpuGovernor.update(buffer.getNumSamples()));
+
+    const juce::AudioProcessLoadMeasurer::ScopedTimer loadTimer(cpuGovernor.loadMeasurer, buffer.getNumSamples());
+    BLOCK_PROFILER_BLOCK(profiler, buffer.getNumSamples());
+
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -161,12 +194,55 @@ void TestProjectAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     bool expected = true;
     if (isNonRealtime() || parametersChanged.compare_exchange_strong(expected, false))
     {
+        BLOCK_PROFILER_STAGE(parameterUpdate);
+        BLOCK_PROFILER_COUNT_PARAMETER_UPDATE();
         update();
     }
 
-    juce::dsp::AudioBlock<float> audioBlock(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(audioBlock);
-    reverb.process(context);
+    // The engines write only the wet signal, and the dry signal stays in the host buffer until
+    // outputStage mixes the two in place, so each host sample is read and written once by the
+    // mix. Hosts may send more than the prepared block size.
+    const auto numChannels = juce::jmin(totalNumInputChannels, wetBuffer.getNumChannels());
+    const auto blockSize = wetBuffer.getNumSamples();
+
+    // With no input channels there is nothing to mix, and without a prepared wet buffer the loop
+    // below would never advance.
+    if (numChannels == 0 || blockSize == 0)
+        return;
+
+    juce::dsp::AudioBlock<float> hostBlock(buffer);
+    juce::dsp::AudioBlock<float> wetBlock(wetBuffer);
+
+    for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+    {
+        const auto numSamples = juce::jmin(blockSize, buffer.getNumSamples() - start);
+
+        juce::dsp::AudioBlock<const float> dryBlock = hostBlock.getSubsetChannelBlock(0, (size_t) numChannels)
+                                                               .getSubBlock((size_t) start, (size_t) numSamples);
+        auto wetSubBlock = wetBlock.getSubsetChannelBlock(0, (size_t) numChannels).getSubBlock(0, (size_t) numSamples);
+
+        {
+            BLOCK_PROFILER_STAGE(engine);
+            reverb.process(dryBlock, wetSubBlock);
+        }
+
+        std::array<float*, 2> channels {};
+        std::array<const float*, 2> wet {};
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            channels[(size_t) channel] = buffer.getWritePointer(channel, start);
+            wet[(size_t) channel] = wetBuffer.getReadPointer(channel);
+        }
+
+        {
+            BLOCK_PROFILER_STAGE(output);
+            outputStage.process(channels.data(), wet.data(), numChannels, numSamples);
+        }
+
+        // The followers run inside outputStage, so their share of it is reported as analysis.
+        BLOCK_PROFILER_MOVE_CYCLES(output, analysis, outputStage.takeAnalysisCycles());
+    }
 }
 
 //==============================================================================
@@ -185,15 +261,23 @@ juce::AudioProcessorEditor* TestProjectAudioProcessor::createEditor()
 //==============================================================================
 void TestProjectAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    if (auto xml = apvts.copyState().createXml())
+        copyXmlToBinary(*xml, destData);
 }
 
 void TestProjectAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    // Loading a preset morphs to it rather than jumping.
+    std::unique_ptr<juce::XmlElement> xml(getXmlFromBinary(data, sizeInBytes));
+
+    if (xml != nullptr && xml->hasTagName(apvts.state.getType()))
+    {
+        apvts.replaceState(juce::ValueTree::fromXml(*xml));
+
+        // Set once the whole preset is in, so the morph doesn't go to a half-loaded one.
+        morphOnNextUpdate.store(true);
+        parametersChanged.store(true);
+    }
 }
 
 //==============================================================================
@@ -209,11 +293,32 @@ void TestProjectAudioProcessor::update()
 
     reverbParams.roomSize = roomSizeParameter->get();
     reverbParams.damping = dampingParameter->get();
-    reverbParams.wetLevel = wetLevelParameter->get();
-    reverbParams.dryLevel = dryLevelParameter->get();
+    reverbParams.wetLevel = 1.f; // wet, dry and width are applied by outputStage
+    reverbParams.dryLevel = 0.f;
+    reverbParams.width = 1.f;
     reverbParams.freezeMode = float(freezeParameter->get());
     
-    reverb.setParameters(reverbParams);
+    const MorphingReverb::Configuration configuration { static_cast<ReverbEngine::Type>(engineParameter->getIndex()),
+                                                       reverbParams };
+
+    reverb.setNonRealtime(isNonRealtime());
+    reverb.setMorphTime(morphTimeParameter->get());
+    reverb.setConfiguration(configuration, morphOnNextUpdate.exchange(false));
+
+    const auto maximumQuality = static_cast<FDNReverb::Quality>(qualityParameter->getIndex());
+    cpuGovernor.setMaximumQuality(maximumQuality);
+    cpuGovernor.setBudget(maxCpuParameter->get());
+
+    outputStage.setLevels(dryLevelParameter->get(), wetLevelParameter->get());
+    outputStage.setWidth(widthParameter->get());
+    outputStage.setOutputGain(outputGainParameter->get());
+    outputStage.setDucking(duckThresholdParameter->get(), duckDepthParameter->get(), duckReleaseParameter->get(),
+                           static_cast<OutputStage::Detector>(duckDetectorParameter->getIndex()));
+    outputStage.setGate(gateThresholdParameter->get(), gateReleaseParameter->get(),
+                        static_cast<OutputStage::Detector>(gateDetectorParameter->getIndex()));
+
+    if (isNonRealtime())
+        reverb.setQuality(maximumQuality);
 }
 juce::AudioProcessorValueTreeState::ParameterLayout TestProjectAudioProcessor::createParameterLayout()
 {
@@ -250,6 +355,67 @@ juce::AudioProcessorValueTreeState::ParameterLayout TestProjectAudioProcessor::c
         "Freeze",
         false, // Default value for the bool parameter
         juce::AudioParameterBoolAttributes()));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        myParameterID::r_engine,
+        "Engine",
+        juce::StringArray { "JUCE Reverb", "FDN", "Velvet" }, 0));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        myParameterID::r_quality,
+        "Quality",
+        juce::StringArray { "Low (4 lines)", "Medium (8 lines)", "High (16 lines)" }, 2));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        myParameterID::r_maxcpu,
+        "Max CPU",
+        juce::NormalisableRange<float>(5.f, 100.f, 1.f), 50.f,
+        juce::AudioParameterFloatAttributes().withLabel("%")));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        myParameterID::r_duckthreshold,
+        "Duck Threshold",
+        juce::NormalisableRange<float>(-60.f, 0.f, 0.1f), -30.f,
+        juce::AudioParameterFloatAttributes().withLabel("dB")));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        myParameterID::r_duckdepth,
+        "Duck Depth",
+        juce::NormalisableRange<float>(0.f, 40.f, 0.1f), 0.f,
+        juce::AudioParameterFloatAttributes().withLabel("dB")));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        myParameterID::r_duckrelease,
+        "Duck Release",
+        juce::NormalisableRange<float>(10.f, 2000.f, 1.f, 0.3f), 250.f,
+        juce::AudioParameterFloatAttributes().withLabel("ms")));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        myParameterID::r_duckdetector,
+        "Duck Detector",
+        juce::StringArray { "Peak", "RMS" }, 0));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        myParameterID::r_gatethreshold,
+        "Gate Threshold",
+        juce::NormalisableRange<float>(OutputStage::gateOffDb, 0.f, 0.1f), OutputStage::gateOffDb,
+        juce::AudioParameterFloatAttributes()
+            .withLabel("dB")
+            .withStringFromValueFunction([] (float value, int)
+            {
+                return value <= OutputStage::gateOffDb ? juce::String("Off") : juce::String(value, 1);
+            })));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        myParameterID::r_gaterelease,
+        "Gate Release",
+        juce::NormalisableRange<float>(10.f, 2000.f, 1.f, 0.3f), 150.f,
+        juce::AudioParameterFloatAttributes().withLabel("ms")));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        myParameterID::r_gatedetector,
+        "Gate Detector",
+        juce::StringArray { "Peak", "RMS" }, 1));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        myParameterID::r_output,
+        "Output Gain",
+        juce::NormalisableRange<float>(-24.f, 12.f, 0.1f), 0.f,
+        juce::AudioParameterFloatAttributes().withLabel("dB")));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        myParameterID::r_morphtime,
+        "Morph Time",
+        juce::NormalisableRange<float>(0.05f, 5.f, 0.01f, 0.5f), 0.5f,
+        juce::AudioParameterFloatAttributes().withLabel("s")));
 
     return layout;
 }
\ No newline at end of file
@@ -10,6 +10,10 @@
 
 #include <JuceHeader.h>
 #include "ParameterHandler.h"
+#include "MorphingReverb.h"
+#include "CpuGovernor.h"
+#include "OutputStage.h"
+#include "BlockProfiler.h"
 
 namespace myParameterID {
 #define PARAMETER_ID(str) const juce::ParameterID str(#str, 1);
@@ -19,6 +23,18 @@ namespace myParameterID {
     PARAMETER_ID(r_dry)
     PARAMETER_ID(r_width)
     PARAMETER_ID(r_freeze)
+    PARAMETER_ID(r_engine)
+    PARAMETER_ID(r_quality)
+    PARAMETER_ID(r_maxcpu)
+    PARAMETER_ID(r_duckthreshold)
+    PARAMETER_ID(r_duckdepth)
+    PARAMETER_ID(r_duckrelease)
+    PARAMETER_ID(r_duckdetector)
+    PARAMETER_ID(r_gatethreshold)
+    PARAMETER_ID(r_gaterelease)
+    PARAMETER_ID(r_gatedetector)
+    PARAMETER_ID(r_output)
+    PARAMETER_ID(r_morphtime)
     #undef PARAMETER_ID
 }
 //==============================================================================
@@ -68,7 +84,17 @@ public:
 
 private:
 
-  juce::dsp::Reverb reverb;
+  MorphingReverb reverb;
+  CpuGovernor cpuGovernor;
+  OutputStage outputStage;
+
+    // The engines render only the wet signal into here, and outputStage mixes it back in. This is
+    // the only scratch memory, and it is allocated in prepareToPlay.
+    juce::AudioBuffer<float> wetBuffer;
+
+   #if BLOCK_PROFILING
+    BlockProfiler profiler { "Basic Reverb" };
+   #endif
 
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
@@ -78,6 +104,9 @@ private:
     }
     std::atomic<bool> parametersChanged { false };
 
+    // Set when a whole state is loaded, so the next update crossfades to it instead of jumping.
+    std::atomic<bool> morphOnNextUpdate { false };
+
     void update();
 
     juce::AudioParameterFloat*  roomSizeParameter;
@@ -86,6 +115,18 @@ private:
     juce::AudioParameterFloat*  dryLevelParameter;
     juce::AudioParameterFloat*  widthParameter;
     juce::AudioParameterBool*   freezeParameter;
+    juce::AudioParameterChoice* engineParameter;
+    juce::AudioParameterChoice* qualityParameter;
+    juce::AudioParameterFloat*  maxCpuParameter;
+    juce::AudioParameterFloat*  duckThresholdParameter;
+    juce::AudioParameterFloat*  duckDepthParameter;
+    juce::AudioParameterFloat*  duckReleaseParameter;
+    juce::AudioParameterChoice* duckDetectorParameter;
+    juce::AudioParameterFloat*  gateThresholdParameter;
+    juce::AudioParameterFloat*  gateReleaseParameter;
+    juce::AudioParameterChoice* gateDetectorParameter;
+    juce::AudioParameterFloat*  outputGainParameter;
+    juce::AudioParameterFloat*  morphTimeParameter;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TestProjectAudioProcessor)
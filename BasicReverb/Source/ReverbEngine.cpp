@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    ReverbEngine.cpp
+    Created: 19 Oct 2026 4:07:31pm
+    Author:  Ryan Baker
+
+  ==============================================================================
+*/
+
+#include "ReverbEngine.h"
+
+void ReverbEngine::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    preparedSpec = spec;
+    prepared = true;
+    createEngine();
+}
+
+void ReverbEngine::reset()
+{
+    switch (type)
+    {
+        case Type::fdn:
+            if (fdnReverb != nullptr)
+                fdnReverb->reset();
+            break;
+
+        case Type::velvet:
+            if (velvetReverb != nullptr)
+                velvetReverb->reset();
+            break;
+
+        case Type::juce:
+        default:
+            // juce::dsp::Reverb::reset only clears its filters and leaves its gains ramping.
+            // Preparing it again at the same sample rate also starts them at their targets, like
+            // the other engines, and doesn't allocate because the buffer sizes don't change.
+            if (reverb != nullptr)
+                reverb->prepare(preparedSpec);
+            break;
+    }
+}
+
+void ReverbEngine::setType(Type newType)
+{
+    if (newType == type)
+        return;
+
+    type = newType;
+
+    if (prepared)
+        createEngine();
+}
+
+void ReverbEngine::setParameters(const juce::dsp::Reverb::Parameters& newParams)
+{
+    params = newParams;
+
+    switch (type)
+    {
+        case Type::fdn:    if (fdnReverb != nullptr)    fdnReverb->setParameters(params);    break;
+        case Type::velvet: if (velvetReverb != nullptr) velvetReverb->setParameters(params); break;
+        case Type::juce:
+        default:           if (reverb != nullptr)       reverb->setParameters(params);       break;
+    }
+}
+
+void ReverbEngine::setQuality(FDNReverb::Quality newQuality)
+{
+    quality = newQuality;
+
+    if (type == Type::fdn && fdnReverb != nullptr)
+        fdnReverb->setQuality(newQuality);
+}
+
+void ReverbEngine::resetWithQuality(FDNReverb::Quality newQuality)
+{
+    quality = newQuality;
+
+    if (type == Type::fdn && fdnReverb != nullptr)
+        fdnReverb->resetWithQuality(newQuality);
+    else
+        reset();
+}
+
+//==============================================================================
+void ReverbEngine::createEngine()
+{
+    // Frees the engine there was, even for the same type, so every build starts from the spec.
+    reverb.reset();
+    fdnReverb.reset();
+    velvetReverb.reset();
+
+    switch (type)
+    {
+        case Type::fdn:
+            fdnReverb = std::make_unique<FDNReverb>();
+            fdnReverb->setQuality(quality);
+            fdnReverb->setParameters(params);
+            fdnReverb->prepare(preparedSpec);
+            break;
+
+        case Type::velvet:
+            velvetReverb = std::make_unique<VelvetReverb>();
+            velvetReverb->setParameters(params);
+            velvetReverb->prepare(preparedSpec);
+            break;
+
+        case Type::juce:
+        default:
+            reverb = std::make_unique<juce::dsp::Reverb>();
+            reverb->setParameters(params);
+            reverb->prepare(preparedSpec);
+            break;
+    }
+}
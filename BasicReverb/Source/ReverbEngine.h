@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    ReverbEngine.h
+    Created: 19 Oct 2026 4:07:31pm
+    Author:  Ryan Baker
+
+    All of the reverb engines behind one interface. Only needs juce_dsp, not
+    the plugin wrapper or the GUI, so the same code runs in the plugin, the
+    tests and the Python bindings.
+
+    Only the engine of the selected type exists. Selecting another type
+    builds and prepares that engine and frees the old one, so it is done off
+    the audio thread (MorphingReverb does it on its worker), and an instance
+    running the velvet engine never pays for the FDN's delay lines.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "FDNReverb.h"
+#include "VelvetReverb.h"
+
+class ReverbEngine
+{
+public:
+    enum class Type { juce = 0, fdn, velvet };
+
+    ReverbEngine() = default;
+
+    // Builds and prepares the engine of the current type.
+    void prepare(const juce::dsp::ProcessSpec& spec);
+
+    // Clears the engine and starts its smoothed values at their targets, so what follows is the
+    // response to the current parameters from silence.
+    void reset();
+
+    // Once prepared, this allocates, so never call it on the audio thread.
+    void setType(Type newType);
+    Type getType() const noexcept { return type; }
+
+    // Only the running engine recalculates. Another one picks the parameters up when it is built.
+    void setParameters(const juce::dsp::Reverb::Parameters& newParams);
+
+    // Only the FDN has more than one quality; the other engines ignore this.
+    void setQuality(FDNReverb::Quality newQuality);
+
+    // Like reset(), with the FDN switched straight to the quality instead of crossfading to it.
+    // Not for the audio thread.
+    void resetWithQuality(FDNReverb::Quality newQuality);
+
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        switch (type)
+        {
+            case Type::fdn:    if (fdnReverb != nullptr)    fdnReverb->process(context);    break;
+            case Type::velvet: if (velvetReverb != nullptr) velvetReverb->process(context); break;
+            case Type::juce:
+            default:           if (reverb != nullptr)       reverb->process(context);       break;
+        }
+    }
+
+private:
+    void createEngine();
+
+    Type type = Type::juce;
+    bool prepared = false;
+    juce::dsp::ProcessSpec preparedSpec { 44100.0, 512, 2 };
+    juce::dsp::Reverb::Parameters params;
+    FDNReverb::Quality quality = FDNReverb::Quality::high;
+
+    std::unique_ptr<juce::dsp::Reverb> reverb;
+    std::unique_ptr<FDNReverb> fdnReverb;
+    std::unique_ptr<VelvetReverb> velvetReverb;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReverbEngine)
+};
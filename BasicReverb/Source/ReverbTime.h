@@ -0,0 +1,19 @@
+/*
+  ==============================================================================
+
+    ReverbTime.h
+    Created: 19 Oct 2026 4:07:31pm
+    Author:  Ryan Baker
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Room size (0 to 1) to the reverb time used by the engines that are built around one, from
+// 0.2 s at room size 0 up to 8 s at room size 1.
+inline static float roomSizeToRT60(float roomSize)
+{
+    return 0.2f * std::pow(40.f, roomSize);
+}
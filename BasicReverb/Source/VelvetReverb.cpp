@@ -0,0 +1,317 @@
+/*
+  ==============================================================================
+
+    VelvetReverb.cpp
+    Created: 19 Oct 2026 1:58:17pm
+    Author:  Ryan Baker
+
+  ==============================================================================
+*/
+
+#include "VelvetReverb.h"
+#include "EngineCommon.h"
+#include "ReverbTime.h"
+
+namespace {
+
+constexpr float segmentSeconds  = 0.05f;
+constexpr float pulsesPerSecond = 800.f; // in the first segment
+constexpr float densityFalloff  = 0.7f;  // per segment; the later ones are quieter and darker
+constexpr float allpassGain     = 0.6f;
+constexpr float outputGain      = 0.5f;
+constexpr float darkestCutoffHz = 2400.f; // the last segment and the loop, at full damping
+
+// Allpass lengths in the recursive section, different per channel for decorrelation.
+constexpr std::array<std::array<float, 2>, 2> allpassMs { { { 7.1f, 2.3f }, { 6.7f, 2.9f } } };
+
+constexpr juce::int64 randomSeed = 0x5eed1; // fixed, so renders are repeatable
+
+// Adds the input at every tap to sum (or takes it away), four taps at a time so that sum is only
+// loaded and stored once for every four.
+template <typename Combine>
+void sumTaps(float* sum, const float* block, const std::vector<int>& taps, int numSamples, Combine combine) noexcept
+{
+    size_t t = 0;
+
+    for (; t + 4 <= taps.size(); t += 4)
+    {
+        const float* a = block - taps[t];
+        const float* b = block - taps[t + 1];
+        const float* c = block - taps[t + 2];
+        const float* d = block - taps[t + 3];
+
+        for (int i = 0; i < numSamples; ++i)
+            sum[i] = combine(sum[i], (a[i] + b[i]) + (c[i] + d[i]));
+    }
+
+    for (; t < taps.size(); ++t)
+    {
+        const float* a = block - taps[t];
+
+        for (int i = 0; i < numSamples; ++i)
+            sum[i] = combine(sum[i], a[i]);
+    }
+}
+
+} // namespace
+
+//==============================================================================
+void VelvetReverb::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+    segmentLength = juce::roundToInt(segmentSeconds * sampleRate);
+    maxBlockSize = juce::jmax(1, (int) spec.maximumBlockSize);
+
+    historyLength = segmentLength * numSegments;
+    ringLength = historyLength + maxBlockSize;
+    history.assign((size_t) ringLength * 2, 0.f);
+
+    for (auto& sum : segmentSums)
+        sum.assign((size_t) maxBlockSize, 0.f);
+
+    for (auto& wet : wetBuffers)
+        wet.assign((size_t) maxBlockSize, 0.f);
+
+    // Every segment has the same energy whatever its density; the decay is applied on top.
+    juce::Random random(randomSeed);
+
+    for (int k = 0; k < numSegments; ++k)
+    {
+        const float density = pulsesPerSecond * std::pow(densityFalloff, (float) k);
+        const int numPulses = juce::jmax(1, juce::roundToInt(density * segmentSeconds));
+
+        segments[(size_t) k].generate(random, k * segmentLength, segmentLength, numPulses);
+        segments[(size_t) k].pulseGain = outputGain / std::sqrt((float) numPulses);
+    }
+
+    for (size_t i = 0; i < channels.size(); ++i)
+    {
+        auto& channel = channels[i];
+
+        // An allpass delays by its length on average across frequency, so the loop buffer is
+        // shortened by those lengths to keep one pass at one segment length.
+        int loopLength = segmentLength;
+
+        for (size_t a = 0; a < channel.allpasses.size(); ++a)
+        {
+            const int allpassLength = juce::roundToInt(allpassMs[i][a] * 0.001 * sampleRate);
+            channel.allpasses[a].setSize(allpassLength);
+            loopLength -= allpassLength;
+        }
+
+        channel.loopBuffer.assign((size_t) juce::jmax(1, loopLength), 0.f);
+    }
+
+    mix.prepare(sampleRate);
+
+    setParameters(params);
+    reset();
+}
+
+void VelvetReverb::reset()
+{
+    std::fill(history.begin(), history.end(), 0.f);
+    writeIndex = 0;
+
+    for (auto& segment : segments)
+        segment.lowpassState.fill(0.f);
+
+    for (auto& channel : channels)
+        channel.clear();
+
+    mix.snap();
+}
+
+void VelvetReverb::setParameters(const juce::dsp::Reverb::Parameters& newParams)
+{
+    params = newParams;
+    mix.setParameters(params);
+
+    const bool frozen = isFrozen(params.freezeMode);
+    const float rt60 = roomSizeToRT60(params.roomSize);
+    const float samplesPerDecade = rt60 * (float) sampleRate / 3.f; // -20 dB per decade of amplitude
+
+    // Each segment is scaled for the decay at its centre, and darkened a bit more than the last.
+    // With no damping the lowpasses are bypassed, or the loop would darken the tail on every pass
+    // and the broadband decay would come out short of the target.
+    for (int k = 0; k < numSegments; ++k)
+    {
+        const float centre = ((float) k + 0.5f) * (float) segmentLength;
+        const float darkening = params.damping * (float) (k + 1) / (float) numSegments;
+
+        segmentGains[(size_t) k] = segments[(size_t) k].pulseGain * std::pow(10.f, -centre / samplesPerDecade);
+        segmentCoefficients[(size_t) k] = juce::jmap(darkening, 1.f, onePoleCoefficient(darkestCutoffHz, sampleRate));
+    }
+
+    inputGain = frozen ? 0.f : 1.f;
+    loopGain = frozen ? 1.f : std::pow(10.f, -(float) segmentLength / samplesPerDecade);
+    loopCoefficient = frozen ? 1.f : segmentCoefficients.back();
+}
+
+//==============================================================================
+void VelvetReverb::renderWet(const float* block, float* wetLeft, float* wetRight, int numSamples) noexcept
+{
+    // First the sums, over the whole block for each tap, so every tap is a contiguous add.
+    for (size_t k = 0; k < (size_t) numSegments; ++k)
+    {
+        for (size_t group = 0; group < 2; ++group)
+        {
+            float* sum = segmentSums[k * 2 + group].data();
+            std::fill(sum, sum + numSamples, 0.f);
+
+            sumTaps(sum, block, segments[k].positiveTaps[group], numSamples, std::plus<float>());
+            sumTaps(sum, block, segments[k].negativeTaps[group], numSamples, std::minus<float>());
+        }
+    }
+
+    // Then one pass over the block for everything recursive. The eight lowpasses and the two
+    // recursive sections don't depend on each other, so their work overlaps instead of each
+    // running at the latency of its own feedback.
+    std::array<std::array<float, 2>, numSegments> state;
+
+    for (size_t k = 0; k < (size_t) numSegments; ++k)
+        state[k] = segments[k].lowpassState;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float left = 0.f, right = 0.f, lastA = 0.f, lastB = 0.f;
+
+        for (size_t k = 0; k < (size_t) numSegments; ++k)
+        {
+            const float gain = segmentGains[k], coefficient = segmentCoefficients[k];
+
+            lastA = state[k][0] += coefficient * (segmentSums[k * 2][(size_t) i] * gain - state[k][0]);
+            lastB = state[k][1] += coefficient * (segmentSums[k * 2 + 1][(size_t) i] * gain - state[k][1]);
+
+            left  += lastA + lastB;
+            right += lastA - lastB;
+        }
+
+        // The last segment feeds the recursive sections.
+        wetLeft[i]  = left + channels[0].process(lastA + lastB, loopGain, loopCoefficient);
+        wetRight[i] = right + channels[1].process(lastA - lastB, loopGain, loopCoefficient);
+    }
+
+    for (size_t k = 0; k < (size_t) numSegments; ++k)
+        segments[k].lowpassState = state[k];
+}
+
+void VelvetReverb::renderBlock(const float* left, const float* right, int numSamples) noexcept
+{
+    for (int done = 0; done < numSamples;)
+    {
+        // Stop at the end of the ring, so the newest samples are one run in the second copy.
+        const int num = juce::jmin(numSamples - done, ringLength - writeIndex);
+        float* first = history.data() + writeIndex;
+        float* second = first + ringLength;
+
+        for (int i = 0; i < num; ++i)
+            first[i] = second[i] = 0.5f * (left[done + i] + right[done + i]) * inputGain;
+
+        renderWet(second, wetBuffers[0].data() + done, wetBuffers[1].data() + done, num);
+
+        done += num;
+        writeIndex = writeIndex + num < ringLength ? writeIndex + num : 0;
+    }
+}
+
+void VelvetReverb::processMono(const float* input, float* output, int numSamples) noexcept
+{
+    for (int start = 0; start < numSamples; start += maxBlockSize)
+    {
+        const int num = juce::jmin(maxBlockSize, numSamples - start);
+        const float* in = input + start;
+        float* out = output + start;
+
+        renderBlock(in, in, num);
+
+        for (int i = 0; i < num; ++i)
+            out[i] = mix.mixMono(in[i], wetBuffers[0][(size_t) i], wetBuffers[1][(size_t) i]);
+    }
+}
+
+void VelvetReverb::processStereo(const float* inLeft, const float* inRight, float* outLeft, float* outRight, int numSamples) noexcept
+{
+    for (int start = 0; start < numSamples; start += maxBlockSize)
+    {
+        const int num = juce::jmin(maxBlockSize, numSamples - start);
+        const float* blockLeft = inLeft + start;
+        const float* blockRight = inRight + start;
+
+        renderBlock(blockLeft, blockRight, num);
+
+        for (int i = 0; i < num; ++i)
+            mix.mixStereo(blockLeft[i], blockRight[i], wetBuffers[0][(size_t) i], wetBuffers[1][(size_t) i],
+                          outLeft[start + i], outRight[start + i]);
+    }
+}
+
+//==============================================================================
+void VelvetReverb::Segment::generate(juce::Random& random, int start, int length, int numPulses)
+{
+    // One pulse at a random position inside each grid period, with a random sign and group.
+    const float gridPeriod = (float) length / (float) numPulses;
+
+    for (size_t group = 0; group < 2; ++group)
+    {
+        positiveTaps[group].clear();
+        negativeTaps[group].clear();
+    }
+
+    for (int m = 0; m < numPulses; ++m)
+    {
+        const int offset = juce::jmin(length - 1, (int) (((float) m + random.nextFloat()) * gridPeriod));
+        const auto group = random.nextBool() ? (size_t) 1 : (size_t) 0;
+        auto& taps = random.nextBool() ? positiveTaps[group] : negativeTaps[group];
+        taps.push_back(start + offset);
+    }
+}
+
+void VelvetReverb::Channel::clear() noexcept
+{
+    std::fill(loopBuffer.begin(), loopBuffer.end(), 0.f);
+    loopIndex = 0;
+    loopLowpassState = 0.f;
+
+    for (auto& allpass : allpasses)
+        allpass.clear();
+}
+
+float VelvetReverb::Channel::process(float input, float gain, float coefficient) noexcept
+{
+    // On average one segment length of delay, diffused and damped on every pass, so the last
+    // segment keeps repeating with the decay it would have had as a longer FIR.
+    auto& delayed = loopBuffer[(size_t) loopIndex];
+    float tail = allpasses[1].process(allpasses[0].process(delayed));
+
+    loopLowpassState += coefficient * (tail - loopLowpassState);
+    tail = gain * loopLowpassState;
+
+    delayed = input + tail;
+    loopIndex = loopIndex + 1 < (int) loopBuffer.size() ? loopIndex + 1 : 0;
+
+    return tail;
+}
+
+void VelvetReverb::Allpass::setSize(int newSize)
+{
+    buffer.assign((size_t) juce::jmax(1, newSize), 0.f);
+    index = 0;
+}
+
+void VelvetReverb::Allpass::clear() noexcept
+{
+    std::fill(buffer.begin(), buffer.end(), 0.f);
+    index = 0;
+}
+
+float VelvetReverb::Allpass::process(float input) noexcept
+{
+    const float delayed = buffer[(size_t) index];
+    const float v = input - allpassGain * delayed;
+
+    buffer[(size_t) index] = v;
+    index = index + 1 < (int) buffer.size() ? index + 1 : 0;
+
+    return delayed + allpassGain * v;
+}
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    VelvetReverb.h
+    Created: 19 Oct 2026 1:58:17pm
+    Author:  Ryan Baker
+
+    Low CPU late reverb built from velvet noise: sparse FIR segments of +1/-1
+    pulses, 800 per second in the first segment and thinning out in the later,
+    quieter ones. Each segment is a plain sum of taps (no multiplies) followed
+    by one gain and one lowpass, so the cost is about a hundred additions per
+    sample instead of a dense convolution. The sums run a block at a time, so
+    each tap is a contiguous, vectorisable add. The input history is a
+    mirrored ring (every sample is written twice, half a ring apart), so the
+    taps always read one contiguous run and nothing is ever moved.
+
+    Both channels share the pulse positions. The pulses are split into two
+    random groups, and the right channel flips the sign of one of them, so
+    left is A + B and right is A - B: two uncorrelated outputs for the price
+    of one set of sums.
+
+    The FIR covers the first few hundred milliseconds. The last segment then
+    feeds a short recursive section (delay, two allpasses, damping, gain)
+    that continues the same exponential decay for as long as the reverb time
+    asks for, or forever in freeze mode.
+
+    Takes the same parameters as juce::dsp::Reverb.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "EngineCommon.h"
+
+class VelvetReverb
+{
+public:
+    static constexpr int numSegments = 4;
+
+    VelvetReverb() = default;
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    void setParameters(const juce::dsp::Reverb::Parameters& newParams);
+    const juce::dsp::Reverb::Parameters& getParameters() const noexcept { return params; }
+
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept { processEngine(*this, context); }
+
+    void processMono(const float* input, float* output, int numSamples) noexcept;
+    void processStereo(const float* inLeft, const float* inRight, float* outLeft, float* outRight, int numSamples) noexcept;
+
+private:
+    struct Allpass
+    {
+        void setSize(int newSize);
+        void clear() noexcept;
+        float process(float input) noexcept;
+
+        std::vector<float> buffer;
+        int index = 0;
+    };
+
+    // The pulses of one FIR segment, shared by both channels.
+    struct Segment
+    {
+        void generate(juce::Random& random, int start, int length, int numPulses);
+
+        // Tap offsets into the input history for groups A and B, split by sign so each group is
+        // two plain sums. Left is A + B and right is A - B.
+        std::array<std::vector<int>, 2> positiveTaps, negativeTaps;
+        std::array<float, 2> lowpassState {};
+        float pulseGain = 0.f;
+    };
+
+    // The recursive section of one output channel, different per channel for decorrelation.
+    struct Channel
+    {
+        void clear() noexcept;
+        float process(float input, float gain, float coefficient) noexcept;
+
+        std::vector<float> loopBuffer;
+        int loopIndex = 0;
+        std::array<Allpass, 2> allpasses;
+        float loopLowpassState = 0.f;
+    };
+
+    void renderWet(const float* block, float* wetLeft, float* wetRight, int numSamples) noexcept;
+    void renderBlock(const float* left, const float* right, int numSamples) noexcept;
+
+    juce::dsp::Reverb::Parameters params; // defaults as in juce::dsp::Reverb
+    double sampleRate = 44100.0;
+    int segmentLength = 0, maxBlockSize = 0;
+
+    // A ring of input long enough for the FIR plus one block, stored twice in a row. The taps of
+    // a block then always read one contiguous run of samples, wherever the ring has wrapped to,
+    // and nothing has to be moved between blocks.
+    std::vector<float> history;
+    int historyLength = 0, ringLength = 0, writeIndex = 0;
+
+    std::array<std::vector<float>, numSegments * 2> segmentSums; // A and B for each segment
+    std::array<std::vector<float>, 2> wetBuffers;
+
+    std::array<Segment, numSegments> segments;
+    std::array<Channel, 2> channels;
+    std::array<float, numSegments> segmentGains {}, segmentCoefficients {};
+    float inputGain = 1.f, loopGain = 0.f, loopCoefficient = 1.f;
+
+    EngineMix mix;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VelvetReverb)
+};
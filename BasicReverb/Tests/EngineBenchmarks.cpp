@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    EngineBenchmarks.cpp
+    Created: 19 Oct 2026 3:20:44pm
+    Author:  Ryan Baker
+
+    Times each reverb engine on stereo noise and prints how many instances
+    of it one core could run in real time.
+
+        basicReverbBenchmarks [--seconds=<audio seconds>] [--block-size=<n>] [--sample-rate=<hz>]
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "FDNReverb.h"
+#include "VelvetReverb.h"
+
+namespace {
+
+struct Settings
+{
+    double sampleRate = 48000.0;
+    int blockSize = 512;
+    double seconds = 20.0;
+};
+
+template <typename Engine>
+double secondsToProcess(Engine& engine, const Settings& settings)
+{
+    juce::dsp::ProcessSpec spec { settings.sampleRate, (juce::uint32) settings.blockSize, 2 };
+    engine.prepare(spec);
+
+    juce::AudioBuffer<float> buffer(2, settings.blockSize);
+    juce::Random random(1);
+    const auto numBlocks = (int) (settings.seconds * settings.sampleRate / settings.blockSize);
+    double elapsed = 0.0;
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < settings.blockSize; ++i)
+                buffer.setSample(channel, i, random.nextFloat() * 2.f - 1.f);
+
+        juce::dsp::AudioBlock<float> audioBlock(buffer);
+        juce::dsp::ProcessContextReplacing<float> context(audioBlock);
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        engine.process(context);
+        elapsed += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+    }
+
+    return elapsed;
+}
+
+template <typename Engine>
+void report(const juce::String& name, Engine& engine, const Settings& settings)
+{
+    const auto elapsed = secondsToProcess(engine, settings);
+    const auto nanosecondsPerFrame = elapsed * 1.0e9 / (settings.seconds * settings.sampleRate);
+
+    std::cout << name.paddedRight(' ', 20)
+              << juce::String(nanosecondsPerFrame, 1).paddedLeft(' ', 10) << " ns/frame"
+              << juce::String(settings.seconds / elapsed, 0).paddedLeft(' ', 10) << " instances/core"
+              << std::endl;
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+    Settings settings;
+
+    if (args.containsOption("--seconds"))
+        settings.seconds = args.getValueForOption("--seconds").getDoubleValue();
+    if (args.containsOption("--block-size"))
+        settings.blockSize = args.getValueForOption("--block-size").getIntValue();
+    if (args.containsOption("--sample-rate"))
+        settings.sampleRate = args.getValueForOption("--sample-rate").getDoubleValue();
+
+    std::cout << "Stereo, " << settings.sampleRate << " Hz, blocks of " << settings.blockSize << std::endl;
+
+    juce::dsp::Reverb juceReverb;
+    report("JUCE Reverb", juceReverb, settings);
+
+    for (auto quality : { FDNReverb::Quality::high, FDNReverb::Quality::medium, FDNReverb::Quality::low })
+    {
+        FDNReverb fdnReverb;
+        fdnReverb.setQuality(quality);
+        report("FDN " + juce::String(FDNReverb::getConfiguration(quality).numLines) + " lines", fdnReverb, settings);
+    }
+
+    VelvetReverb velvetReverb;
+    report("Velvet", velvetReverb, settings);
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+    GovernorTests.cpp
+    Created: 20 Oct 2026 10:04:17am
+    Author:  Ryan Baker
+
+    Feeds synthetic loads into CpuGovernor's decision logic. The golden cases
+    all render offline, which bypasses the governor, so this is the only
+    coverage it has.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "CpuGovernor.h"
+
+namespace {
+
+constexpr double sampleRate = 48000.0;
+constexpr int blockSize = 512;
+constexpr float budgetPercent = 50.f;
+
+constexpr float overBudget = 0.9f;
+constexpr float underHalfBudget = 0.1f;
+constexpr float underBudget = 0.4f; // under budget, but not far enough to count towards an upgrade
+
+// Blocks the governor ignores after a change (0.5 s), and blocks of low load before it upgrades (2 s).
+const int settleBlocks = (int) std::ceil(0.5 * sampleRate / blockSize);
+const int upgradeBlocks = (int) std::ceil(2.0 * sampleRate / blockSize);
+
+int numFailures = 0;
+
+void expect(bool condition, const juce::String& description)
+{
+    if (! condition)
+    {
+        std::cout << "FAIL: " << description << std::endl;
+        ++numFailures;
+    }
+}
+
+FDNReverb::Quality feed(CpuGovernor& governor, float load, int numBlocks, int numSamples = blockSize)
+{
+    auto quality = governor.getQuality();
+
+    for (int i = 0; i < numBlocks; ++i)
+        quality = governor.update(numSamples, load);
+
+    return quality;
+}
+
+void prepare(CpuGovernor& governor)
+{
+    governor.setBudget(budgetPercent);
+    governor.setMaximumQuality(FDNReverb::Quality::high);
+    governor.prepare(sampleRate, blockSize);
+}
+
+void testDowngrade()
+{
+    CpuGovernor governor;
+    prepare(governor);
+
+    expect(feed(governor, overBudget, 3) == FDNReverb::Quality::high, "stays up for 3 blocks over budget");
+    expect(feed(governor, overBudget, 1) == FDNReverb::Quality::medium, "drops on the 4th block over budget");
+
+    // A block under budget starts the count again.
+    feed(governor, underBudget, settleBlocks);
+    feed(governor, overBudget, 3);
+    feed(governor, underBudget, 1);
+    expect(feed(governor, overBudget, 3) == FDNReverb::Quality::medium, "a block under budget resets the count");
+    expect(feed(governor, overBudget, 1) == FDNReverb::Quality::low, "drops again after 4 blocks in a row");
+
+    expect(feed(governor, overBudget, 1000) == FDNReverb::Quality::low, "never drops below low");
+}
+
+void testSettleTime()
+{
+    CpuGovernor governor;
+    prepare(governor);
+
+    feed(governor, overBudget, 4);
+    expect(governor.getQuality() == FDNReverb::Quality::medium, "dropped to medium");
+
+    // Overload during the settle time is ignored, including the crossfade to the new quality.
+    expect(feed(governor, overBudget, settleBlocks) == FDNReverb::Quality::medium, "ignores load while settling");
+    expect(feed(governor, overBudget, 3) == FDNReverb::Quality::medium, "counts from the end of the settle time");
+    expect(feed(governor, overBudget, 1) == FDNReverb::Quality::low, "drops 4 blocks after settling");
+}
+
+void testUpgrade()
+{
+    CpuGovernor governor;
+    prepare(governor);
+
+    feed(governor, overBudget, 4);
+    feed(governor, underHalfBudget, settleBlocks);
+
+    expect(feed(governor, underHalfBudget, upgradeBlocks - 1) == FDNReverb::Quality::medium, "waits 2 s before climbing");
+    expect(feed(governor, underHalfBudget, 1) == FDNReverb::Quality::high, "climbs after 2 s under half the budget");
+
+    // Load between half the budget and the budget holds the quality, but restarts the 2 s.
+    feed(governor, overBudget, settleBlocks + 4);
+    expect(governor.getQuality() == FDNReverb::Quality::medium, "dropped to medium again");
+    feed(governor, underHalfBudget, settleBlocks + upgradeBlocks - 1);
+    feed(governor, underBudget, 1);
+    expect(feed(governor, underHalfBudget, upgradeBlocks - 1) == FDNReverb::Quality::medium,
+           "load over half the budget restarts the wait");
+    expect(feed(governor, underHalfBudget, 1) == FDNReverb::Quality::high, "climbs 2 s after that");
+
+    expect(feed(governor, underHalfBudget, 1000) == FDNReverb::Quality::high, "never climbs over high");
+}
+
+void testMaximumQuality()
+{
+    CpuGovernor governor;
+    prepare(governor);
+
+    governor.setMaximumQuality(FDNReverb::Quality::medium);
+    expect(feed(governor, underHalfBudget, 1) == FDNReverb::Quality::medium, "follows a lower maximum at once");
+    expect(feed(governor, underHalfBudget, settleBlocks + 10 * upgradeBlocks) == FDNReverb::Quality::medium,
+           "doesn't climb over the maximum");
+}
+
+void testLongSession()
+{
+    CpuGovernor governor;
+    prepare(governor);
+
+    // A day of idle blocks at the top quality. The under-budget count used to overflow after
+    // about 12 hours at 48 kHz.
+    const int blocksPerDay = (int) (24.0 * 60.0 * 60.0 * sampleRate / 8192.0);
+    expect(feed(governor, underHalfBudget, blocksPerDay, 8192) == FDNReverb::Quality::high, "stays high for a day");
+    expect(feed(governor, overBudget, 4) == FDNReverb::Quality::medium, "still drops after a day");
+
+    // And a day stuck at the bottom.
+    feed(governor, overBudget, settleBlocks + 4);
+    expect(feed(governor, overBudget, blocksPerDay, 8192) == FDNReverb::Quality::low, "stays low for a day");
+    expect(feed(governor, underHalfBudget, upgradeBlocks) == FDNReverb::Quality::medium, "still climbs after a day");
+}
+
+} // namespace
+
+//==============================================================================
+int main()
+{
+    testDowngrade();
+    testSettleTime();
+    testUpgrade();
+    testMaximumQuality();
+    testLongSession();
+
+    std::cout << (numFailures == 0 ? "All governor tests passed" : "Governor tests failed") << std::endl;
+    return numFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,45 @@
+# Adds one CTest test per case in the runner's own case table.
+
+# CTest includes this before it runs anything, so the list always comes from `basicReverbTests --list`
+# and a case added to RegressionTests.cpp can't be left out. The including file sets:
+#   runner        path to basicReverbTests
+#   goldenDir     directory of the golden WAVs
+#   allowMissing  whether a case without a golden file is skipped instead of failed
+
+if (NOT EXISTS "${runner}")
+    # Reported as a failing test rather than silently running nothing.
+    add_test(ir.not_built "${runner}" --list)
+    return()
+endif()
+
+execute_process(COMMAND "${runner}" --list
+                OUTPUT_VARIABLE caseList
+                RESULT_VARIABLE listResult)
+
+if (NOT listResult EQUAL 0)
+    add_test(ir.list_failed "${runner}" --list)
+    return()
+endif()
+
+string(REPLACE "\r" "" caseList "${caseList}")
+string(REPLACE "\n" ";" caseList "${caseList}")
+
+foreach(irCase IN LISTS caseList)
+    if (irCase STREQUAL "")
+        continue()
+    endif()
+
+    # The decay cases check the reverb time instead of a golden file.
+    if (irCase MATCHES "^decay_")
+        add_test(ir.${irCase} "${runner}" --case=${irCase} --golden-dir=${goldenDir})
+        set_tests_properties(ir.${irCase} PROPERTIES LABELS decay)
+    elseif (allowMissing)
+        add_test(ir.${irCase} "${runner}" --case=${irCase} --golden-dir=${goldenDir} --allow-missing-golden)
+
+        # The runner exits with 77 when a case has no golden file yet.
+        set_tests_properties(ir.${irCase} PROPERTIES LABELS golden SKIP_RETURN_CODE 77)
+    else()
+        add_test(ir.${irCase} "${runner}" --case=${irCase} --golden-dir=${goldenDir})
+        set_tests_properties(ir.${irCase} PROPERTIES LABELS golden)
+    endif()
+endforeach()
@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+
+    IRComparison.cpp
+    Created: 19 Oct 2026 9:12:40am
+    Author:  Ryan Baker
+
+  ==============================================================================
+*/
+
+#include "IRComparison.h"
+
+namespace irTest {
+
+namespace {
+
+float sampleOrZero(const juce::AudioBuffer<float>& buffer, int channel, int index)
+{
+    return index < buffer.getNumSamples() ? buffer.getSample(channel, index) : 0.f;
+}
+
+// Schroeder backward integration, in dB relative to the total energy of the channel.
+std::vector<double> energyDecayCurve(const juce::AudioBuffer<float>& buffer, int channel, int length)
+{
+    std::vector<double> edc((size_t) length);
+    double energy = 0.0;
+
+    for (int i = length; --i >= 0;)
+    {
+        const double x = sampleOrZero(buffer, channel, i);
+        energy += x * x;
+        edc[(size_t) i] = energy;
+    }
+
+    const double total = juce::jmax(energy, 1.0e-30);
+
+    for (auto& e : edc)
+        e = 10.0 * std::log10(e / total + 1.0e-30);
+
+    return edc;
+}
+
+// Energy per third-octave band from 20 Hz up to Nyquist.
+std::vector<double> thirdOctaveBandEnergies(const juce::AudioBuffer<float>& buffer, int channel,
+                                            int length, double sampleRate)
+{
+    const int order = juce::jmin(20, juce::jmax(1, (int) std::ceil(std::log2((double) length))));
+    juce::dsp::FFT fft(order);
+
+    std::vector<float> data((size_t) fft.getSize() * 2, 0.f);
+    for (int i = 0; i < juce::jmin(length, fft.getSize()); ++i)
+        data[(size_t) i] = sampleOrZero(buffer, channel, i);
+
+    fft.performFrequencyOnlyForwardTransform(data.data());
+
+    const double binWidth = sampleRate / fft.getSize();
+    const int numBins = fft.getSize() / 2;
+    std::vector<double> bands;
+
+    for (double lower = 20.0; lower < sampleRate * 0.5; lower *= std::pow(2.0, 1.0 / 3.0))
+    {
+        const double upper = lower * std::pow(2.0, 1.0 / 3.0);
+        const int first = (int) std::ceil(lower / binWidth);
+        const int last = juce::jmin(numBins, (int) std::ceil(upper / binWidth));
+        double energy = 0.0;
+
+        for (int bin = first; bin < last; ++bin)
+            energy += (double) data[(size_t) bin] * data[(size_t) bin];
+
+        if (last > first)
+            bands.push_back(energy);
+    }
+
+    return bands;
+}
+
+} // namespace
+
+//==============================================================================
+bool ComparisonResult::passes(const Tolerance& tolerance) const
+{
+    return layoutMatches
+        && maxAbsError <= tolerance.maxAbsError
+        && edcDeviationDb <= tolerance.edcDeviationDb
+        && spectralDistanceDb <= tolerance.spectralDistanceDb;
+}
+
+juce::String ComparisonResult::toString() const
+{
+    if (! layoutMatches)
+        return "channel count differs from golden";
+
+    return "max abs error " + juce::String(maxAbsError, 7)
+         + ", EDC deviation " + juce::String(edcDeviationDb, 3) + " dB"
+         + ", spectral distance " + juce::String(spectralDistanceDb, 3) + " dB";
+}
+
+ComparisonResult compareImpulseResponses(const juce::AudioBuffer<float>& rendered,
+                                         const juce::AudioBuffer<float>& golden,
+                                         double sampleRate)
+{
+    ComparisonResult result;
+
+    if (rendered.getNumChannels() != golden.getNumChannels())
+    {
+        result.layoutMatches = false;
+        return result;
+    }
+
+    const int length = juce::jmax(rendered.getNumSamples(), golden.getNumSamples());
+
+    for (int channel = 0; channel < golden.getNumChannels(); ++channel)
+    {
+        for (int i = 0; i < length; ++i)
+        {
+            const float error = std::abs(sampleOrZero(rendered, channel, i) - sampleOrZero(golden, channel, i));
+            result.maxAbsError = juce::jmax(result.maxAbsError, error);
+        }
+
+        // Only the first 60 dB of the golden decay is compared; below that the curve is dominated by
+        // rounding noise and the deviation means nothing.
+        const auto renderedEdc = energyDecayCurve(rendered, channel, length);
+        const auto goldenEdc = energyDecayCurve(golden, channel, length);
+
+        for (size_t i = 0; i < goldenEdc.size() && goldenEdc[i] > -60.0; ++i)
+            result.edcDeviationDb = juce::jmax(result.edcDeviationDb, (float) std::abs(renderedEdc[i] - goldenEdc[i]));
+
+        const auto renderedBands = thirdOctaveBandEnergies(rendered, channel, length, sampleRate);
+        const auto goldenBands = thirdOctaveBandEnergies(golden, channel, length, sampleRate);
+        const double floor = juce::jmax(1.0e-30, *std::max_element(goldenBands.begin(), goldenBands.end()) * 1.0e-10);
+        double sumOfSquares = 0.0;
+
+        for (size_t band = 0; band < goldenBands.size(); ++band)
+        {
+            const double difference = 10.0 * std::log10((renderedBands[band] + floor) / (goldenBands[band] + floor));
+            sumOfSquares += difference * difference;
+        }
+
+        const float distance = (float) std::sqrt(sumOfSquares / (double) juce::jmax((size_t) 1, goldenBands.size()));
+        result.spectralDistanceDb = juce::jmax(result.spectralDistanceDb, distance);
+    }
+
+    return result;
+}
+
+float estimateRT60(const juce::AudioBuffer<float>& ir, int channel, double sampleRate)
+{
+    const auto edc = energyDecayCurve(ir, channel, ir.getNumSamples());
+    double sumT = 0.0, sumDb = 0.0, sumTT = 0.0, sumTDb = 0.0;
+    int count = 0;
+
+    for (size_t i = 0; i < edc.size() && edc[i] >= -25.0; ++i)
+    {
+        if (edc[i] > -5.0)
+            continue;
+
+        const double t = (double) i / sampleRate;
+        sumT += t;
+        sumDb += edc[i];
+        sumTT += t * t;
+        sumTDb += t * edc[i];
+        ++count;
+    }
+
+    const double denominator = count * sumTT - sumT * sumT;
+
+    if (count < 2 || denominator <= 0.0)
+        return 0.f;
+
+    const double slope = (count * sumTDb - sumT * sumDb) / denominator; // dB per second
+    return slope < 0.0 ? (float) (-60.0 / slope) : 0.f;
+}
+
+//==============================================================================
+bool readGolden(const juce::File& file, juce::AudioBuffer<float>& destination, double& sampleRate)
+{
+    if (! file.existsAsFile())
+        return false;
+
+    auto stream = file.createInputStream();
+
+    if (stream == nullptr)
+        return false;
+
+    // The reader owns the stream once it is created, and deletes it if it can't parse it.
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(stream.release(), true));
+
+    if (reader == nullptr)
+        return false;
+
+    destination.setSize((int) reader->numChannels, (int) reader->lengthInSamples);
+    sampleRate = reader->sampleRate;
+
+    return reader->read(&destination, 0, (int) reader->lengthInSamples, 0, true, true);
+}
+
+bool writeGolden(const juce::File& file, const juce::AudioBuffer<float>& source, double sampleRate)
+{
+    file.getParentDirectory().createDirectory();
+    file.deleteFile();
+
+    juce::WavAudioFormat wav;
+    auto stream = file.createOutputStream();
+
+    if (stream == nullptr)
+        return false;
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate,
+                                                                        (unsigned int) source.getNumChannels(),
+                                                                        32, {}, 0));
+    if (writer == nullptr)
+        return false;
+
+    stream.release(); // the writer owns the stream now
+    return writer->writeFromAudioSampleBuffer(source, 0, source.getNumSamples());
+}
+
+} // namespace irTest
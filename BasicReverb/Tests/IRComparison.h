@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    IRComparison.h
+    Created: 19 Oct 2026 9:12:40am
+    Author:  Ryan Baker
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace irTest {
+
+// How far a rendered IR may drift from its golden file before the case fails.
+struct Tolerance
+{
+    float maxAbsError        = 1.0e-4f; // linear, per sample
+    float edcDeviationDb     = 0.5f;    // energy decay curve, over the first 60 dB of decay
+    float spectralDistanceDb = 0.5f;    // RMS difference of third-octave band energies
+    float rt60Deviation      = 0.1f;    // fraction of the target, for cases that check the decay time
+};
+
+struct ComparisonResult
+{
+    float maxAbsError        = 0.f;
+    float edcDeviationDb     = 0.f;
+    float spectralDistanceDb = 0.f;
+    bool  layoutMatches      = true;
+
+    bool passes(const Tolerance& tolerance) const;
+    juce::String toString() const;
+};
+
+ComparisonResult compareImpulseResponses(const juce::AudioBuffer<float>& rendered,
+                                         const juce::AudioBuffer<float>& golden,
+                                         double sampleRate);
+
+// Reverb time of one channel from a straight line fitted to its energy decay curve between -5 and
+// -25 dB (T20). The IR should run at least as long as the reverb time, or the fit is bent by the end.
+float estimateRT60(const juce::AudioBuffer<float>& ir, int channel, double sampleRate);
+
+// Golden files are 32-bit float WAVs, so they can also be auditioned in any editor.
+bool readGolden(const juce::File& file, juce::AudioBuffer<float>& destination, double& sampleRate);
+bool writeGolden(const juce::File& file, const juce::AudioBuffer<float>& source, double sampleRate);
+
+} // namespace irTest
@@ -0,0 +1,291 @@
+/*
+  ==============================================================================
+
+    RegressionTests.cpp
+    Created: 19 Oct 2026 9:12:40am
+    Author:  Ryan Baker
+
+    Renders impulse responses at fixed parameter sets and compares them against
+    the golden files in Tests/Golden.
+
+        basicReverbTests --case=<name> --golden-dir=<dir>   run one case
+        basicReverbTests --all --golden-dir=<dir>           run every case on all cores
+        basicReverbTests --list                             print the case names
+
+    The decay cases have no golden file; they check the reverb time measured
+    from the render against the one the engine is built around, or against
+    another engine's at the same settings.
+
+    Add --update-golden to overwrite the golden files instead of comparing.
+    A case without a golden file fails, unless --allow-missing-golden is
+    given, in which case it exits with 77 (skipped).
+
+  ==============================================================================
+*/
+
+#include "IRComparison.h"
+#include "PluginProcessor.h"
+#include "ReverbTime.h"
+
+namespace {
+
+enum ExitCode { passed = 0, failed = 1, usageError = 2, noGolden = 77 };
+
+struct IRCase
+{
+    juce::String name;
+    std::vector<std::pair<juce::String, float>> parameters; // plain (not normalised) values
+    int blockSize = 512;
+    double sampleRate = 48000.0;
+    double lengthSeconds = 2.0;
+    irTest::Tolerance tolerance {};
+
+    // Set part way through the render, so changes and morphs are tested while the tail is ringing.
+    std::vector<std::pair<juce::String, float>> laterParameters {};
+    double laterSeconds = 0.25;
+
+    // Seconds. When set, the case checks its decay time against this instead of a golden file.
+    float targetRT60 = 0.f;
+
+    // When set (0 or more), the case checks its decay time against a render of this engine at the
+    // same settings instead of a golden file.
+    float referenceEngine = -1.f;
+};
+
+// A wet-only render with no damping, so the broadband decay time should be the engine's target.
+IRCase decayCase(const juce::String& name, float engine, float roomSize)
+{
+    IRCase irCase { name, { { "r_engine", engine }, { "r_size", roomSize }, { "r_damping", 0.f }, { "r_dry", 0.f } } };
+    irCase.targetRT60 = roomSizeToRT60(roomSize);
+    irCase.lengthSeconds = juce::jmax(2.0, 1.5 * irCase.targetRT60);
+    return irCase;
+}
+
+// A wet-only render whose decay time should match the reference engine's at the same settings.
+// The engines only share a reverb time around room size 0.5: juce::dsp::Reverb's grows more
+// slowly with room size than the roomSizeToRT60 curve the other engines follow.
+IRCase engineComparisonCase(const juce::String& name, float engine, float referenceEngine, float damping)
+{
+    IRCase irCase { name, { { "r_engine", engine }, { "r_size", 0.5f }, { "r_damping", damping }, { "r_dry", 0.f } } };
+    irCase.referenceEngine = referenceEngine;
+    irCase.tolerance.rt60Deviation = 0.2f;
+    irCase.lengthSeconds = 3.0;
+    return irCase;
+}
+
+const std::vector<IRCase>& getCases()
+{
+    static const std::vector<IRCase> cases
+    {
+        { "processor_default",         {} },
+        { "processor_default_block64", {}, 64 },
+        { "processor_small_room",      { { "r_size", 0.1f }, { "r_damping", 0.8f } } },
+        { "processor_large_room",      { { "r_size", 0.9f }, { "r_damping", 0.2f } }, 512, 48000.0, 4.0 },
+        { "processor_half_wet",        { { "r_wet", 0.5f }, { "r_dry", 0.5f } } },
+        { "processor_fdn_high",        { { "r_engine", 1.f }, { "r_quality", 2.f } } },
+        { "processor_fdn_medium",      { { "r_engine", 1.f }, { "r_quality", 1.f } } },
+        { "processor_fdn_low",         { { "r_engine", 1.f }, { "r_quality", 0.f } } },
+        { "processor_fdn_large_room",  { { "r_engine", 1.f }, { "r_size", 0.9f }, { "r_damping", 0.2f } }, 512, 48000.0, 6.0 },
+        { "processor_velvet_default",  { { "r_engine", 2.f } } },
+        { "processor_velvet_block64",  { { "r_engine", 2.f } }, 64 },
+        { "processor_velvet_small_room", { { "r_engine", 2.f }, { "r_size", 0.1f }, { "r_damping", 0.8f } } },
+        { "processor_velvet_large_room", { { "r_engine", 2.f }, { "r_size", 0.9f }, { "r_damping", 0.2f } }, 512, 48000.0, 6.0 },
+        { "processor_ducked",          { { "r_duckthreshold", -50.f }, { "r_duckdepth", 20.f } } },
+        { "processor_gated",           { { "r_gatethreshold", -50.f }, { "r_gaterelease", 50.f } } },
+        { "processor_gated_peak",      { { "r_gatethreshold", -50.f }, { "r_gatedetector", 0.f } }, 64 },
+        { "processor_narrow",          { { "r_width", 0.f }, { "r_dry", 0.5f } } },
+        { "processor_wide_quiet",      { { "r_width", 1.f }, { "r_output", -12.f } } },
+        { "processor_morph_engine",    { { "r_engine", 1.f } }, 512, 48000.0, 2.0, {}, { { "r_engine", 2.f } } },
+        { "processor_glide_room_jump", { { "r_size", 0.2f } }, 512, 48000.0, 2.0, {}, { { "r_size", 0.9f } } },
+        { "processor_glide_room",      { { "r_size", 0.3f } }, 64, 48000.0, 2.0, {}, { { "r_size", 0.35f } } },
+        decayCase("decay_fdn_small_room",    1.f, 0.2f),
+        decayCase("decay_fdn_large_room",    1.f, 0.7f),
+        decayCase("decay_velvet_small_room", 2.f, 0.2f),
+        decayCase("decay_velvet_large_room", 2.f, 0.7f),
+        engineComparisonCase("decay_velvet_vs_juce",        2.f, 0.f, 0.f),
+        engineComparisonCase("decay_velvet_vs_juce_damped", 2.f, 0.f, 0.5f),
+    };
+
+    return cases;
+}
+
+void setParameters(TestProjectAudioProcessor& processor, const std::vector<std::pair<juce::String, float>>& parameters)
+{
+    for (const auto& [id, value] : parameters)
+    {
+        auto* parameter = processor.apvts.getParameter(id);
+        jassert(parameter != nullptr); // unknown parameter ID in the case table
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+}
+
+juce::AudioBuffer<float> renderProcessorIR(const IRCase& irCase)
+{
+    TestProjectAudioProcessor processor;
+    processor.setPlayConfigDetails(2, 2, irCase.sampleRate, irCase.blockSize);
+
+    // Non-realtime makes processBlock pick up parameter values on every block, so nothing depends
+    // on the value tree listener having fired yet. It also makes morphs prepare on the audio
+    // thread, so they always start on the same block.
+    processor.setNonRealtime(true);
+
+    setParameters(processor, irCase.parameters);
+    processor.prepareToPlay(irCase.sampleRate, irCase.blockSize);
+
+    const int laterStart = (int) std::round(irCase.laterSeconds * irCase.sampleRate);
+    const int length = (int) std::round(irCase.lengthSeconds * irCase.sampleRate);
+    juce::AudioBuffer<float> ir(2, length);
+    juce::MidiBuffer midi;
+
+    ir.clear();
+    for (int channel = 0; channel < ir.getNumChannels(); ++channel)
+        ir.setSample(channel, 0, 1.f);
+
+    for (int start = 0; start < length; start += irCase.blockSize)
+    {
+        if (start <= laterStart && laterStart < start + irCase.blockSize)
+            setParameters(processor, irCase.laterParameters);
+
+        juce::AudioBuffer<float> block(ir.getArrayOfWritePointers(), ir.getNumChannels(),
+                                       start, juce::jmin(irCase.blockSize, length - start));
+        processor.processBlock(block, midi);
+    }
+
+    processor.releaseResources();
+    return ir;
+}
+
+ExitCode checkDecay(const IRCase& irCase, const juce::AudioBuffer<float>& rendered, juce::String& report)
+{
+    std::vector<float> targets((size_t) rendered.getNumChannels(), irCase.targetRT60);
+
+    if (irCase.referenceEngine >= 0.f)
+    {
+        auto referenceCase = irCase;
+
+        for (auto& [id, value] : referenceCase.parameters)
+            if (id == "r_engine")
+                value = irCase.referenceEngine;
+
+        const auto reference = renderProcessorIR(referenceCase);
+
+        for (int channel = 0; channel < reference.getNumChannels(); ++channel)
+            targets[(size_t) channel] = irTest::estimateRT60(reference, channel, irCase.sampleRate);
+    }
+
+    bool ok = true;
+    juce::String measured, expected;
+
+    for (int channel = 0; channel < rendered.getNumChannels(); ++channel)
+    {
+        const float rt60 = irTest::estimateRT60(rendered, channel, irCase.sampleRate);
+        const float target = targets[(size_t) channel];
+
+        ok = ok && target > 0.f && std::abs(rt60 / target - 1.f) <= irCase.tolerance.rt60Deviation;
+        measured << (channel > 0 ? ", " : "") << juce::String(rt60, 2) << " s";
+        expected << (channel > 0 ? ", " : "") << juce::String(target, 2) << " s";
+    }
+
+    report = irCase.name + (ok ? ": PASS (" : ": FAIL (") + "RT60 " + measured + ", expected " + expected
+           + " within " + juce::String(juce::roundToInt(irCase.tolerance.rt60Deviation * 100.f)) + "%)";
+    return ok ? passed : failed;
+}
+
+ExitCode runCase(const IRCase& irCase, const juce::File& goldenDir, bool updateGolden, bool allowMissingGolden,
+                 juce::String& report)
+{
+    const auto rendered = renderProcessorIR(irCase);
+
+    if (irCase.targetRT60 > 0.f || irCase.referenceEngine >= 0.f)
+        return checkDecay(irCase, rendered, report);
+
+    const auto goldenFile = goldenDir.getChildFile(irCase.name + ".wav");
+
+    if (updateGolden)
+    {
+        const bool written = irTest::writeGolden(goldenFile, rendered, irCase.sampleRate);
+        report = irCase.name + (written ? ": wrote " : ": could not write ") + goldenFile.getFullPathName();
+        return written ? passed : failed;
+    }
+
+    juce::AudioBuffer<float> golden;
+    double goldenSampleRate = 0.0;
+
+    if (! irTest::readGolden(goldenFile, golden, goldenSampleRate))
+    {
+        // A missing file must not pass quietly, or a change to the sound goes unnoticed.
+        report = irCase.name + ": no golden file at " + goldenFile.getFullPathName();
+        return allowMissingGolden ? noGolden : failed;
+    }
+
+    if (goldenSampleRate != irCase.sampleRate)
+    {
+        report = irCase.name + ": golden sample rate " + juce::String(goldenSampleRate) + " does not match the case";
+        return failed;
+    }
+
+    const auto result = irTest::compareImpulseResponses(rendered, golden, irCase.sampleRate);
+    const bool ok = result.passes(irCase.tolerance);
+    report = irCase.name + (ok ? ": PASS (" : ": FAIL (") + result.toString() + ")";
+    return ok ? passed : failed;
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--list"))
+    {
+        for (const auto& irCase : getCases())
+            std::cout << irCase.name << std::endl;
+
+        return passed;
+    }
+
+    const auto goldenDir = juce::File::getCurrentWorkingDirectory()
+                               .getChildFile(args.getValueForOption("--golden-dir"));
+    const bool updateGolden = args.containsOption("--update-golden");
+    const bool allowMissingGolden = args.containsOption("--allow-missing-golden");
+    const auto caseName = args.getValueForOption("--case");
+
+    std::vector<const IRCase*> selected;
+    for (const auto& irCase : getCases())
+        if (args.containsOption("--all") || irCase.name == caseName)
+            selected.push_back(&irCase);
+
+    if (args.getValueForOption("--golden-dir").isEmpty() || selected.empty())
+    {
+        std::cerr << "usage: basicReverbTests (--case=<name> | --all | --list) --golden-dir=<dir>"
+                     " [--update-golden] [--allow-missing-golden]" << std::endl;
+        return usageError;
+    }
+
+    std::vector<ExitCode> results(selected.size(), passed);
+    std::vector<juce::String> reports(selected.size());
+
+    {
+        juce::ThreadPool pool(juce::jmax(1, juce::SystemStats::getNumCpus()));
+
+        for (size_t i = 0; i < selected.size(); ++i)
+            pool.addJob([&, i] { results[i] = runCase(*selected[i], goldenDir, updateGolden, allowMissingGolden, reports[i]); });
+
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep(10);
+    }
+
+    ExitCode exitCode = passed;
+
+    for (size_t i = 0; i < selected.size(); ++i)
+    {
+        std::cout << reports[i] << std::endl;
+
+        if (results[i] == failed || (results[i] == noGolden && exitCode == passed))
+            exitCode = results[i];
+    }
+
+    return exitCode;
+}
@@ -95,6 +95,9 @@ void TestPluginAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
 {
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
+   #if BLOCK_PROFILING
+    profiler.prepare (sampleRate);
+   #endif
 }
 
 void TestPluginAudioProcessor::releaseResources()
@@ -132,6 +135,8 @@ bool TestPluginAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
 void TestPluginAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    BLOCK_PROFILER_BLOCK (profiler, buffer.getNumSamples());
+
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -150,6 +155,8 @@ void TestPluginAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, j
     // the samples and the outer loop is handling the channels.
     // Alternatively, you can process the samples with the channels
     // interleaved by keeping the same state.
+    BLOCK_PROFILER_STAGE (engine);
+
     for (int channel = 0; channel < totalNumInputChannels; ++channel)
     {
         auto* channelData = buffer.getWritePointer (channel);
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "BlockProfiler.h"
 
 //==============================================================================
 /**
@@ -58,5 +59,9 @@ public:
 
 private:
     //==============================================================================
+   #if BLOCK_PROFILING
+    BlockProfiler profiler { "Torch Plugin" };
+   #endif
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TestPluginAudioProcessor)
 };
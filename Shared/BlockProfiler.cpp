@@ -0,0 +1,243 @@
+/*
+  ==============================================================================
+
+    BlockProfiler.cpp
+    Created: 19 Oct 2026 8:15:03pm
+    Author:  Ryan Baker
+
+  ==============================================================================
+*/
+
+#include "BlockProfiler.h"
+
+#if BLOCK_PROFILING
+
+namespace {
+
+constexpr int exportIntervalMs = 250;
+
+const char* const stageNames[] { "parameter update", "engine", "analysis", "output" };
+
+std::atomic<int> nextInstance { 1 };
+
+int bucketFor(double microseconds) noexcept
+{
+    return microseconds < 1.0 ? 0 : juce::jmin(63, (int) (4.0 * std::log2(microseconds)));
+}
+
+double bucketStart(int bucket) noexcept
+{
+    return std::pow(2.0, bucket / 4.0);
+}
+
+} // namespace
+
+//==============================================================================
+BlockProfiler::BlockProfiler(const juce::String& processorName)
+    : name(processorName), instance(nextInstance++)
+{
+    ring.allocate((size_t) capacity, true);
+    exporter->add(*this);
+}
+
+BlockProfiler::~BlockProfiler()
+{
+    exporter->remove(*this);
+}
+
+void BlockProfiler::push(const Block& block) noexcept
+{
+    const auto scope = fifo.write(1);
+
+    if (scope.blockSize1 > 0)
+        ring[scope.startIndex1] = block;
+    else
+        ++dropped; // the exporter has fallen behind; it reports how many were lost
+}
+
+//==============================================================================
+BlockProfiler::Exporter::Exporter()
+    : juce::Thread("Block profiler export")
+{
+    const auto format = juce::SystemStats::getEnvironmentVariable("BLOCK_PROFILER_FORMAT", "trace");
+    const auto path = juce::SystemStats::getEnvironmentVariable("BLOCK_PROFILER_DIR", {});
+
+    writeHistogramFile = format.equalsIgnoreCase("histogram");
+    directory = juce::File::isAbsolutePath(path) ? juce::File(path)
+                                                 : juce::File::getSpecialLocation(juce::File::tempDirectory);
+
+    firstCycle = readCycleCounter();
+    firstTicks = juce::Time::getHighResolutionTicks();
+
+    startThread();
+}
+
+BlockProfiler::Exporter::~Exporter()
+{
+    stopThread(2 * exportIntervalMs);
+    exportAll();
+
+    if (trace != nullptr)
+        trace->writeText("]\n", false, false, nullptr);
+}
+
+void BlockProfiler::Exporter::add(BlockProfiler& profiler)
+{
+    const juce::ScopedLock sl(lock);
+    profilers.add(&profiler);
+    histograms.push_back({ profiler.instance, profiler.name + " #" + juce::String(profiler.instance) });
+
+    if (outputFile == juce::File())
+    {
+        outputFile = directory.getNonexistentChildFile(profiler.name.removeCharacters(" ") + "-blocks",
+                                                       writeHistogramFile ? ".csv" : ".json");
+        juce::Logger::writeToLog("Block profile: " + outputFile.getFullPathName());
+    }
+}
+
+void BlockProfiler::Exporter::remove(BlockProfiler& profiler)
+{
+    // Whatever the instance recorded last still goes in the file.
+    const juce::ScopedLock sl(lock);
+    drain(profiler);
+    profilers.removeFirstMatchingValue(&profiler);
+}
+
+void BlockProfiler::Exporter::run()
+{
+    while (! threadShouldExit())
+    {
+        wait(exportIntervalMs);
+        exportAll();
+    }
+}
+
+void BlockProfiler::Exporter::exportAll()
+{
+    const juce::ScopedLock sl(lock);
+
+    // The counter rate is measured against the high resolution timer, and gets more accurate the
+    // longer the process runs.
+    const auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - firstTicks);
+
+    if (elapsed > 0.0)
+        cyclesPerSecond = (double) (readCycleCounter() - firstCycle) / elapsed;
+
+    for (auto* profiler : profilers)
+        drain(*profiler);
+
+    if (writeHistogramFile)
+        writeHistogram();
+    else if (trace != nullptr)
+        trace->flush();
+}
+
+void BlockProfiler::Exporter::drain(BlockProfiler& profiler)
+{
+    auto& histogram = *std::find_if(histograms.begin(), histograms.end(),
+                                    [&] (const Histogram& h) { return h.instance == profiler.instance; });
+    const auto sampleRate = profiler.sampleRate.load();
+
+    const auto scope = profiler.fifo.read(profiler.fifo.getNumReady());
+
+    for (int i = 0; i < scope.blockSize1 + scope.blockSize2; ++i)
+    {
+        const auto& block = profiler.ring[i < scope.blockSize1 ? scope.startIndex1 + i
+                                                               : scope.startIndex2 + i - scope.blockSize1];
+        const auto duration = toMicroseconds(block.cycles);
+
+        const auto bucket = (size_t) bucketFor(duration);
+        histogram.blocks[bucket]++;
+
+        if (duration * 1.0e-6 * sampleRate > (double) block.numSamples)
+            histogram.overDeadline[bucket]++;
+
+        if (! writeHistogramFile)
+            writeTraceEvents(histogram, block, sampleRate);
+    }
+
+    if (const auto lost = profiler.dropped.exchange(0); lost > 0 && ! writeHistogramFile && trace != nullptr)
+    {
+        *trace << ",\n{\"name\":\"dropped " << (int) lost << " blocks\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":"
+               << profiler.instance << ",\"ts\":" << juce::String(toMicroseconds(readCycleCounter() - firstCycle), 3) << "}";
+    }
+}
+
+void BlockProfiler::Exporter::writeTraceEvents(Histogram& instance, const Block& block, double sampleRate)
+{
+    if (trace == nullptr)
+    {
+        if (traceFailed)
+            return;
+
+        outputFile.deleteFile();
+        trace = outputFile.createOutputStream();
+
+        if (trace == nullptr)
+        {
+            traceFailed = true;
+            juce::Logger::writeToLog("Block profile: can't write " + outputFile.getFullPathName());
+            return;
+        }
+
+        *trace << "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Block profile\"}}";
+    }
+
+    auto& out = *trace;
+
+    // Perfetto shows one track per tid, so each instance gets its own, named on its first block.
+    if (! instance.named)
+    {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << instance.instance
+            << ",\"args\":{\"name\":" << juce::JSON::toString(instance.name) << "}}";
+        instance.named = true;
+    }
+
+    const auto start = toMicroseconds(block.start - firstCycle);
+    const auto seconds = (double) block.numSamples / sampleRate;
+
+    out << ",\n{\"name\":\"processBlock\",\"ph\":\"X\",\"pid\":1,\"tid\":" << instance.instance
+        << ",\"ts\":" << juce::String(start, 3) << ",\"dur\":" << juce::String(toMicroseconds(block.cycles), 3)
+        << ",\"args\":{\"samples\":" << (int) block.numSamples
+        << ",\"parameterUpdates\":" << (int) block.parameterUpdates
+        << ",\"load\":" << juce::String(toMicroseconds(block.cycles) * 1.0e-6 / seconds, 3) << "}}";
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        if (block.stageCycles[(size_t) stage] == 0)
+            continue;
+
+        out << ",\n{\"name\":\"" << stageNames[stage] << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << instance.instance
+            << ",\"ts\":" << juce::String(start + toMicroseconds(block.stageOffsets[(size_t) stage]), 3)
+            << ",\"dur\":" << juce::String(toMicroseconds(block.stageCycles[(size_t) stage]), 3) << "}";
+    }
+}
+
+void BlockProfiler::Exporter::writeHistogram()
+{
+    juce::String csv("instance,from_us,to_us,blocks,over_deadline\n");
+
+    for (const auto& histogram : histograms)
+    {
+        for (int bucket = 0; bucket < numBuckets; ++bucket)
+        {
+            if (histogram.blocks[(size_t) bucket] == 0)
+                continue;
+
+            csv << histogram.instance << ","
+                << juce::String(bucketStart(bucket), 1) << ","
+                << juce::String(bucketStart(bucket + 1), 1) << ","
+                << (juce::int64) histogram.blocks[(size_t) bucket] << ","
+                << (juce::int64) histogram.overDeadline[(size_t) bucket] << "\n";
+        }
+    }
+
+    outputFile.replaceWithText(csv);
+}
+
+double BlockProfiler::Exporter::toMicroseconds(juce::uint64 cycles) const noexcept
+{
+    return cyclesPerSecond > 0.0 ? (double) cycles * 1.0e6 / cyclesPerSecond : 0.0;
+}
+
+#endif
@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+
+    BlockProfiler.h
+    Created: 19 Oct 2026 8:15:03pm
+    Author:  Ryan Baker
+
+    Optional instrumentation for processBlock, shared by the plugins. Build
+    with BLOCK_PROFILING=1 to turn it on; otherwise the macros below expand
+    to nothing and the profiler class doesn't exist.
+
+    Each block records its cycle count, the cycles spent in each stage and
+    the number of parameter updates into a lock-free ring owned by the
+    processor instance. One background thread per process drains every
+    instance's ring and writes either
+
+      - a Chrome/Perfetto trace (JSON), one track per instance, or
+      - a CSV histogram of block times per instance, with the number of
+        blocks that went over their deadline,
+
+    to BLOCK_PROFILER_DIR (default: the temp directory). Set the
+    environment variable BLOCK_PROFILER_FORMAT=histogram for the CSV.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+#ifndef BLOCK_PROFILING
+ #define BLOCK_PROFILING 0
+#endif
+
+#if BLOCK_PROFILING
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+class BlockProfiler
+{
+public:
+    enum class Stage { parameterUpdate = 0, engine, analysis, output, numStages };
+    static constexpr int numStages = (int) Stage::numStages;
+
+    struct Block
+    {
+        juce::uint64 start = 0;   // counter value at the start of the block
+        juce::uint32 cycles = 0;
+        std::array<juce::uint32, numStages> stageCycles {};
+        std::array<juce::uint32, numStages> stageOffsets {}; // from the start of the block
+        juce::uint32 numSamples = 0;
+        juce::uint32 parameterUpdates = 0;
+    };
+
+    explicit BlockProfiler(const juce::String& processorName);
+    ~BlockProfiler();
+
+    void prepare(double newSampleRate) noexcept { sampleRate.store(newSampleRate); }
+
+    // The CPU's time stamp counter where there is one, otherwise the high resolution timer. The
+    // exporter works out its rate against the high resolution timer.
+    static juce::uint64 readCycleCounter() noexcept
+    {
+       #if JUCE_INTEL
+        return (juce::uint64) __rdtsc();
+       #elif JUCE_ARM && JUCE_64BIT && ! JUCE_MSVC
+        juce::uint64 ticks;
+        asm volatile ("mrs %0, cntvct_el0" : "=r" (ticks));
+        return ticks;
+       #else
+        return (juce::uint64) juce::Time::getHighResolutionTicks();
+       #endif
+    }
+
+    //==============================================================================
+    // Times one processBlock call and pushes it to the ring when it goes out of scope.
+    class ScopedBlock
+    {
+    public:
+        ScopedBlock(BlockProfiler& newProfiler, int numSamples) noexcept
+            : profiler(newProfiler)
+        {
+            block.numSamples = (juce::uint32) numSamples;
+            block.start = readCycleCounter();
+        }
+
+        ~ScopedBlock()
+        {
+            block.cycles = toCycles(readCycleCounter() - block.start);
+            profiler.push(block);
+        }
+
+        // Stages that run more than once in a block (one per sub-block, say) are summed, and
+        // placed where they first ran.
+        void addStage(Stage stage, juce::uint64 stageStart, juce::uint64 stageEnd) noexcept
+        {
+            const auto index = (size_t) stage;
+
+            if (block.stageCycles[index] == 0)
+                block.stageOffsets[index] = toCycles(stageStart - block.start);
+
+            block.stageCycles[index] += toCycles(stageEnd - stageStart);
+        }
+
+        // For stages that are fused into another one and timed from inside it. The moved stage is
+        // placed at the start of the one it came out of, so the two don't overlap in a trace.
+        void moveCycles(Stage from, Stage to, juce::uint64 cycles) noexcept
+        {
+            const auto moved = juce::jmin(block.stageCycles[(size_t) from], toCycles(cycles));
+
+            if (moved == 0)
+                return;
+
+            if (block.stageCycles[(size_t) to] == 0)
+            {
+                block.stageOffsets[(size_t) to] = block.stageOffsets[(size_t) from];
+                block.stageOffsets[(size_t) from] += moved;
+            }
+
+            block.stageCycles[(size_t) from] -= moved;
+            block.stageCycles[(size_t) to] += moved;
+        }
+
+        void countParameterUpdate() noexcept { ++block.parameterUpdates; }
+
+    private:
+        static juce::uint32 toCycles(juce::uint64 cycles) noexcept
+        {
+            return (juce::uint32) juce::jmin(cycles, (juce::uint64) std::numeric_limits<juce::uint32>::max());
+        }
+
+        BlockProfiler& profiler;
+        Block block;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedBlock)
+    };
+
+    class ScopedStage
+    {
+    public:
+        ScopedStage(ScopedBlock& newBlock, Stage newStage) noexcept
+            : block(newBlock), stage(newStage), start(readCycleCounter())
+        {
+        }
+
+        ~ScopedStage() { block.addStage(stage, start, readCycleCounter()); }
+
+    private:
+        ScopedBlock& block;
+        Stage stage;
+        juce::uint64 start;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    };
+
+    //==============================================================================
+    // The process-wide thread that drains every profiler and writes the files.
+    class Exporter : private juce::Thread
+    {
+    public:
+        Exporter();
+        ~Exporter() override;
+
+        void add(BlockProfiler& profiler);
+        void remove(BlockProfiler& profiler);
+
+    private:
+        void run() override;
+        void exportAll();
+        void drain(BlockProfiler& profiler);
+        struct Histogram;
+        void writeTraceEvents(Histogram& instance, const Block& block, double sampleRate);
+        void writeHistogram();
+        double toMicroseconds(juce::uint64 cycles) const noexcept;
+
+        static constexpr int numBuckets = 64; // quarter octaves from 1 us up to 65 ms
+
+        struct Histogram
+        {
+            int instance = 0;
+            juce::String name;
+            bool named = false;
+            std::array<juce::uint64, numBuckets> blocks {}, overDeadline {};
+        };
+
+        juce::CriticalSection lock;
+        juce::Array<BlockProfiler*> profilers;
+        std::vector<Histogram> histograms;
+
+        bool writeHistogramFile = false;
+        juce::File directory, outputFile;
+        std::unique_ptr<juce::FileOutputStream> trace;
+        bool traceFailed = false; // the file couldn't be opened, so the trace is off for this run
+        juce::uint64 firstCycle = 0;
+        juce::int64 firstTicks = 0;
+        double cyclesPerSecond = 0.0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Exporter)
+    };
+
+private:
+    void push(const Block& block) noexcept;
+
+    static constexpr int capacity = 8192;
+
+    const juce::String name;
+    const int instance;
+    std::atomic<double> sampleRate { 44100.0 };
+
+    // Single producer (the audio thread), single consumer (the exporter).
+    juce::AbstractFifo fifo { capacity };
+    juce::HeapBlock<Block> ring;
+    std::atomic<juce::uint32> dropped { 0 };
+
+    juce::SharedResourcePointer<Exporter> exporter;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BlockProfiler)
+};
+
+#define BLOCK_PROFILER_BLOCK(profiler, numSamples) \
+    BlockProfiler::ScopedBlock blockProfilerBlock(profiler, numSamples)
+#define BLOCK_PROFILER_STAGE(stage) \
+    const BlockProfiler::ScopedStage JUCE_JOIN_MACRO(blockProfilerStage, __LINE__)(blockProfilerBlock, BlockProfiler::Stage::stage)
+#define BLOCK_PROFILER_MOVE_CYCLES(fromStage, toStage, cycles) \
+    blockProfilerBlock.moveCycles(BlockProfiler::Stage::fromStage, BlockProfiler::Stage::toStage, cycles)
+#define BLOCK_PROFILER_COUNT_PARAMETER_UPDATE() \
+    blockProfilerBlock.countParameterUpdate()
+
+#else
+
+#define BLOCK_PROFILER_BLOCK(profiler, numSamples)
+#define BLOCK_PROFILER_STAGE(stage)
+#define BLOCK_PROFILER_MOVE_CYCLES(fromStage, toStage, cycles)
+#define BLOCK_PROFILER_COUNT_PARAMETER_UPDATE()
+
+#endif